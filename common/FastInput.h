@@ -0,0 +1,242 @@
+/* Быстрый ввод для всех задач.
+ * MappedInput отображает файл в память через mmap (или читает stdin целиком одним буфером),
+ * InputReader разбирает из диапазона байт целые числа, строки и символы так же,
+ * как это делает operator>> у std::istream, но без локалей и виртуальных вызовов. */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <type_traits>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#define READ_CHUNK_SIZE (1 << 16)
+#define SIMD_WIDTH 16
+
+class MappedInput {
+ public:
+  // advice передаётся в madvise: MADV_SEQUENTIAL для разбора подряд,
+  // MADV_RANDOM для поиска, который читает лишь отдельные страницы
+  explicit MappedInput(int fd, int advice = MADV_SEQUENTIAL)
+      : data(nullptr), size(0), mapped(false) {
+    struct stat st = {};
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+      void *addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (addr != MAP_FAILED) {
+        madvise(addr, st.st_size, advice);
+        data = static_cast<const char *>(addr);
+        size = st.st_size;
+        mapped = true;
+        return;
+      }
+    }
+
+    slurp(fd);
+  }
+
+  explicit MappedInput(const char *path, int advice = MADV_SEQUENTIAL)
+      : data(nullptr), size(0), mapped(false) {
+    int fd = open(path, O_RDONLY);
+    if (fd == -1) {
+      return;
+    }
+
+    MappedInput input(fd, advice);
+    std::swap(data, input.data);
+    std::swap(size, input.size);
+    std::swap(mapped, input.mapped);
+    storage.swap(input.storage);
+    if (!mapped) {
+      data = storage.data();
+    }
+    close(fd);
+  }
+
+  ~MappedInput() {
+    if (mapped) {
+      munmap(const_cast<char *>(data), size);
+    }
+  }
+
+  const char *begin() const {
+    return data;
+  }
+
+  const char *end() const {
+    return data + size;
+  }
+
+  MappedInput(const MappedInput &other) = delete;
+  MappedInput(MappedInput &&other) = delete;
+  MappedInput &operator=(const MappedInput &other) = delete;
+  MappedInput &operator=(MappedInput &&other) = delete;
+
+ private:
+  const char *data;
+  size_t size;
+  bool mapped;
+  std::vector<char> storage;
+
+  void slurp(int fd) {
+    size_t used = 0;
+    storage.resize(READ_CHUNK_SIZE);
+    while (true) {
+      if (used == storage.size()) {
+        storage.resize(storage.size() * 2);
+      }
+
+      ssize_t got = read(fd, storage.data() + used, storage.size() - used);
+      if (got <= 0) {
+        break;
+      }
+      used += got;
+    }
+
+    storage.resize(used);
+    data = storage.data();
+    size = used;
+  }
+};
+
+class InputReader {
+ public:
+  InputReader(const char *begin, const char *end)
+      : pos(begin), last(end), failed(false) {
+  }
+
+  template<typename T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, char>::value, int>::type = 0>
+  InputReader &operator>>(T &value) {
+    value = 0;
+    skipSpaces();
+    if (failed || pos == last) {
+      failed = true;
+      return *this;
+    }
+
+    bool negative = false;
+    if (*pos == '-' || *pos == '+') {
+      negative = *pos == '-';
+      ++pos;
+    }
+
+    const char *digitsEnd = scanDigits(pos);
+    if (digitsEnd == pos) {
+      failed = true;
+      return *this;
+    }
+
+    typename std::make_unsigned<T>::type result = 0;
+    for (; pos != digitsEnd; ++pos) {
+      result = result * 10 + static_cast<unsigned>(*pos - '0');
+    }
+
+    value = static_cast<T>(negative ? 0 - result : result);
+    return *this;
+  }
+
+  InputReader &operator>>(char &value) {
+    value = 0;
+    skipSpaces();
+    if (failed || pos == last) {
+      failed = true;
+      return *this;
+    }
+
+    value = *pos++;
+    return *this;
+  }
+
+  InputReader &operator>>(std::string &value) {
+    skipSpaces();
+    if (failed || pos == last) {
+      failed = true;
+      return *this;
+    }
+
+    const char *wordEnd = scanWord(pos);
+    value.assign(pos, wordEnd);
+    pos = wordEnd;
+    return *this;
+  }
+
+  explicit operator bool() const {
+    return !failed;
+  }
+
+ private:
+  const char *pos;
+  const char *last;
+  bool failed;
+
+  static bool isSpace(char c) {
+    return static_cast<unsigned char>(c) <= ' ';
+  }
+
+  static bool isDigit(char c) {
+    return static_cast<unsigned char>(c - '0') < 10;
+  }
+
+  void skipSpaces() {
+#ifdef __SSE2__
+    const __m128i space = _mm_set1_epi8(' ');
+    while (last - pos >= SIMD_WIDTH) {
+      __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pos));
+      // Беззнаковое c <= ' ' через min: min(c, ' ') == c
+      int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(chunk, space), chunk));
+      if (mask != 0xFFFF) {
+        pos += __builtin_ctz(~mask);
+        return;
+      }
+      pos += SIMD_WIDTH;
+    }
+#endif
+    while (pos != last && isSpace(*pos)) {
+      ++pos;
+    }
+  }
+
+  const char *scanDigits(const char *from) const {
+#ifdef __SSE2__
+    const __m128i zero = _mm_set1_epi8('0');
+    const __m128i nine = _mm_set1_epi8(9);
+    while (last - from >= SIMD_WIDTH) {
+      __m128i chunk = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(from)), zero);
+      int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(chunk, nine), chunk));
+      if (mask != 0xFFFF) {
+        return from + __builtin_ctz(~mask);
+      }
+      from += SIMD_WIDTH;
+    }
+#endif
+    while (from != last && isDigit(*from)) {
+      ++from;
+    }
+    return from;
+  }
+
+  const char *scanWord(const char *from) const {
+#ifdef __SSE2__
+    const __m128i space = _mm_set1_epi8(' ');
+    while (last - from >= SIMD_WIDTH) {
+      __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(from));
+      int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(chunk, space), chunk));
+      if (mask != 0) {
+        return from + __builtin_ctz(mask);
+      }
+      from += SIMD_WIDTH;
+    }
+#endif
+    while (from != last && !isSpace(*from)) {
+      ++from;
+    }
+    return from;
+  }
+};
@@ -0,0 +1,171 @@
+/* Быстрый вывод для всех задач.
+ * OutputWriter копит токены в одном большом переиспользуемом буфере, сам переводит
+ * целые числа в текст и сбрасывает буфер одним системным вызовом (write/writev)
+ * либо одним os.write, если вывод идёт в std::ostream. */
+
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <cstring>
+#include <type_traits>
+
+#include <unistd.h>
+#include <sys/uio.h>
+
+#define OUTPUT_BUFFER_SIZE (1 << 16)
+#define MAX_INT_DIGITS 24
+
+class OutputWriter {
+ public:
+  explicit OutputWriter(int fd)
+      : fd(fd), stream(nullptr), used(0), buffer(new char[OUTPUT_BUFFER_SIZE]) {
+  }
+
+  explicit OutputWriter(std::ostream &os)
+      : fd(-1), stream(&os), used(0), buffer(new char[OUTPUT_BUFFER_SIZE]) {
+  }
+
+  ~OutputWriter() {
+    flush();
+    delete[] buffer;
+  }
+
+  template<typename T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, char>::value, int>::type = 0>
+  OutputWriter &operator<<(T value) {
+    if (OUTPUT_BUFFER_SIZE - used < MAX_INT_DIGITS) {
+      flush();
+    }
+
+    static const char DIGIT_PAIRS[] =
+        "00010203040506070809"
+        "10111213141516171819"
+        "20212223242526272829"
+        "30313233343536373839"
+        "40414243444546474849"
+        "50515253545556575859"
+        "60616263646566676869"
+        "70717273747576777879"
+        "80818283848586878889"
+        "90919293949596979899";
+
+    typename std::make_unsigned<T>::type rest = value;
+    if (value < T()) {
+      buffer[used++] = '-';
+      rest = 0 - rest;
+    }
+
+    char digits[MAX_INT_DIGITS];
+    char *pos = digits + MAX_INT_DIGITS;
+    while (rest >= 100) {
+      unsigned pair = static_cast<unsigned>(rest % 100) * 2;
+      rest /= 100;
+      *--pos = DIGIT_PAIRS[pair + 1];
+      *--pos = DIGIT_PAIRS[pair];
+    }
+    if (rest >= 10) {
+      unsigned pair = static_cast<unsigned>(rest) * 2;
+      *--pos = DIGIT_PAIRS[pair + 1];
+      *--pos = DIGIT_PAIRS[pair];
+    } else {
+      *--pos = static_cast<char>('0' + rest);
+    }
+
+    size_t length = digits + MAX_INT_DIGITS - pos;
+    std::memcpy(buffer + used, pos, length);
+    used += length;
+    return *this;
+  }
+
+  OutputWriter &operator<<(char value) {
+    if (used == OUTPUT_BUFFER_SIZE) {
+      flush();
+    }
+
+    buffer[used++] = value;
+    return *this;
+  }
+
+  OutputWriter &operator<<(const char *value) {
+    write(value, std::strlen(value));
+    return *this;
+  }
+
+  OutputWriter &operator<<(const std::string &value) {
+    write(value.data(), value.size());
+    return *this;
+  }
+
+  // Поддержка std::endl и std::flush, чтобы код, написанный для std::ostream, собирался без изменений
+  OutputWriter &operator<<(std::ostream &(*manip)(std::ostream &)) {
+    if (manip == static_cast<std::ostream &(*)(std::ostream &)>(std::endl)) {
+      *this << '\n';
+    } else if (manip == static_cast<std::ostream &(*)(std::ostream &)>(std::flush)) {
+      flush();
+    }
+    return *this;
+  }
+
+  void write(const char *data, size_t size) {
+    if (OUTPUT_BUFFER_SIZE - used >= size) {
+      std::memcpy(buffer + used, data, size);
+      used += size;
+      return;
+    }
+
+    if (stream) {
+      flush();
+      stream->write(data, size);
+      return;
+    }
+
+    // Длинный кусок не копируем в буфер, а отправляем вместе с ним одним writev
+    iovec parts[2] = {{buffer, used}, {const_cast<char *>(data), size}};
+    writeAll(parts, 2);
+    used = 0;
+  }
+
+  void flush() {
+    if (used == 0) {
+      return;
+    }
+
+    if (stream) {
+      stream->write(buffer, used);
+    } else {
+      iovec part = {buffer, used};
+      writeAll(&part, 1);
+    }
+    used = 0;
+  }
+
+  OutputWriter(const OutputWriter &other) = delete;
+  OutputWriter(OutputWriter &&other) = delete;
+  OutputWriter &operator=(const OutputWriter &other) = delete;
+  OutputWriter &operator=(OutputWriter &&other) = delete;
+
+ private:
+  int fd;
+  std::ostream *stream;
+  size_t used;
+  char *buffer;
+
+  void writeAll(iovec *parts, int count) {
+    while (count > 0) {
+      ssize_t written = writev(fd, parts, count);
+      if (written <= 0) {
+        return;
+      }
+
+      while (count > 0 && static_cast<size_t>(written) >= parts->iov_len) {
+        written -= parts->iov_len;
+        ++parts;
+        --count;
+      }
+      if (count > 0) {
+        parts->iov_base = static_cast<char *>(parts->iov_base) + written;
+        parts->iov_len -= written;
+      }
+    }
+  }
+};
@@ -0,0 +1,110 @@
+/* Сырая выровненная память для растущих контейнеров (Queue, Stack, Heap).
+ * Ячейки не конструируются заранее: элемент создаётся placement new при вставке
+ * и разрушается при извлечении, при расширении элементы перемещаются, а не копируются.
+ * Для тривиально копируемых T все операции сводятся к memcpy. */
+
+#pragma once
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template<typename T>
+T *allocateStorage(int count) {
+  size_t alignment = alignof(T) < sizeof(void *) ? sizeof(void *) : alignof(T);
+  void *memory = nullptr;
+  if (posix_memalign(&memory, alignment, (count > 0 ? count : 1) * sizeof(T)) != 0) {
+    throw std::bad_alloc();
+  }
+
+  return static_cast<T *>(memory);
+}
+
+template<typename T>
+void freeStorage(T *storage) {
+  free(storage);
+}
+
+template<typename T>
+void destroyElements(T *from, int count) {
+  if (!std::is_trivially_destructible<T>::value) {
+    for (int i = 0; i < count; ++i) {
+      from[i].~T();
+    }
+  }
+}
+
+// Копирует count элементов в неинициализированную память
+template<typename T>
+void copyConstruct(T *to, const T *from, int count, std::true_type) {
+  if (count > 0) {
+    std::memcpy(static_cast<void *>(to), from, count * sizeof(T));
+  }
+}
+
+template<typename T>
+void copyConstruct(T *to, const T *from, int count, std::false_type) {
+  for (int i = 0; i < count; ++i) {
+    new(to + i) T(from[i]);
+  }
+}
+
+template<typename T>
+void copyConstruct(T *to, const T *from, int count) {
+  copyConstruct(to, from, count, std::is_trivially_copyable<T>());
+}
+
+// Переносит count элементов в неинициализированную память и разрушает исходные
+template<typename T>
+void relocateElements(T *to, T *from, int count, std::true_type) {
+  if (count > 0) {
+    std::memcpy(static_cast<void *>(to), from, count * sizeof(T));
+  }
+}
+
+template<typename T>
+void relocateElements(T *to, T *from, int count, std::false_type) {
+  for (int i = 0; i < count; ++i) {
+    new(to + i) T(std::move(from[i]));
+    from[i].~T();
+  }
+}
+
+template<typename T>
+void relocateElements(T *to, T *from, int count) {
+  relocateElements(to, from, count, std::is_trivially_copyable<T>());
+}
+
+// Перемещает count элементов в уже инициализированные ячейки и разрушает исходные
+template<typename T>
+void moveOutElements(T *to, T *from, int count, std::true_type) {
+  if (count > 0) {
+    std::memcpy(static_cast<void *>(to), from, count * sizeof(T));
+  }
+}
+
+template<typename T>
+void moveOutElements(T *to, T *from, int count, std::false_type) {
+  for (int i = 0; i < count; ++i) {
+    to[i] = std::move(from[i]);
+    from[i].~T();
+  }
+}
+
+template<typename T>
+void moveOutElements(T *to, T *from, int count) {
+  moveOutElements(to, from, count, std::is_trivially_copyable<T>());
+}
+
+// Что возвращают Pop/extractTop пустого контейнера: -1, как раньше для чисел, иначе T()
+template<typename T>
+typename std::enable_if<std::is_arithmetic<T>::value, T>::type emptyValue() {
+  return T(-1);
+}
+
+template<typename T>
+typename std::enable_if<!std::is_arithmetic<T>::value, T>::type emptyValue() {
+  return T();
+}
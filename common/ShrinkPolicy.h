@@ -0,0 +1,56 @@
+/* Политика возврата памяти для растущих контейнеров (Queue, Stack, Heap).
+ * Буфер уменьшается в factor раз, когда занято меньше 1/fillDivisor ёмкости, но не раньше,
+ * чем через cooldown удалений после прошлого перевыделения. Порог сжатия (1/4) далеко от порога
+ * роста (полный буфер), поэтому на границе буфер не перевыделяется туда-обратно. */
+
+#pragma once
+
+#define SHRINK_FILL_DIVISOR 4
+#define SHRINK_FACTOR 2
+#define SHRINK_COOLDOWN 64
+
+class ShrinkPolicy {
+ public:
+  explicit ShrinkPolicy(int fillDivisor = SHRINK_FILL_DIVISOR,
+                        int factor = SHRINK_FACTOR,
+                        int cooldown = SHRINK_COOLDOWN)
+      : fillDivisor(fillDivisor), factor(factor), cooldown(cooldown), removals(0) {
+  }
+
+  // Буфер никогда не уменьшается сам, только через ShrinkToFit
+  static ShrinkPolicy never() {
+    return ShrinkPolicy(0, SHRINK_FACTOR, 0);
+  }
+
+  // Вызывается после удаления count элементов. Возвращает новую ёмкость,
+  // не меньше minCapacity, или capacity, если сжимать пока не нужно
+  int onRemove(int size, int capacity, int minCapacity, int count = 1) {
+    // Счётчик не растёт дальше cooldown, иначе он переполнится в долгой работе без перевыделений
+    if (removals < cooldown) {
+      removals += count;
+    }
+    if (fillDivisor <= 0 || factor <= 1 || removals < cooldown) {
+      return capacity;
+    }
+    if (static_cast<long long>(size) * fillDivisor >= capacity) {
+      return capacity;
+    }
+
+    int target = capacity / factor;
+    if (target < minCapacity) {
+      target = minCapacity;
+    }
+    return target < size || target >= capacity ? capacity : target;
+  }
+
+  // Вызывается при любом перевыделении буфера, с него отсчитывается cooldown
+  void onResize() {
+    removals = 0;
+  }
+
+ private:
+  int fillDivisor;
+  int factor;
+  int cooldown;
+  int removals;
+};
@@ -0,0 +1,114 @@
+/* Пул потоков для пакетных режимов задач.
+ * Потоки создаются один раз; parallelFor раздаёт индексы [0, count) через атомарный
+ * счётчик всем рабочим потокам и вызывающему потоку и возвращается, когда все задачи выполнены. */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+ public:
+  explicit ThreadPool(int threads = defaultThreads())
+      : count(0), next(0), active(0), generation(0), stopped(false) {
+    for (int i = 1; i < threads; ++i) {
+      workers.emplace_back([this] { workerLoop(); });
+    }
+  }
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopped = true;
+    }
+    wakeUp.notify_all();
+    for (auto &worker : workers) {
+      worker.join();
+    }
+  }
+
+  int size() const {
+    return static_cast<int>(workers.size()) + 1;
+  }
+
+  void parallelFor(int tasks, const std::function<void(int)> &task) {
+    if (tasks <= 0) {
+      return;
+    }
+    if (workers.empty() || tasks == 1) {
+      for (int i = 0; i < tasks; ++i) {
+        task(i);
+      }
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      job = task;
+      count = tasks;
+      next = 0;
+      active = static_cast<int>(workers.size());
+      ++generation;
+    }
+    wakeUp.notify_all();
+
+    drain();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this] { return active == 0; });
+    job = nullptr;
+  }
+
+  static int defaultThreads() {
+    unsigned hardware = std::thread::hardware_concurrency();
+    return hardware == 0 ? 1 : static_cast<int>(hardware);
+  }
+
+  ThreadPool(const ThreadPool &other) = delete;
+  ThreadPool(ThreadPool &&other) = delete;
+  ThreadPool &operator=(const ThreadPool &other) = delete;
+  ThreadPool &operator=(ThreadPool &&other) = delete;
+
+ private:
+  std::vector<std::thread> workers;
+  std::function<void(int)> job;
+  int count;
+  std::atomic<int> next;
+  int active;
+  long long generation;
+  bool stopped;
+  std::mutex mutex;
+  std::condition_variable wakeUp;
+  std::condition_variable finished;
+
+  void drain() {
+    for (int i = next++; i < count; i = next++) {
+      job(i);
+    }
+  }
+
+  void workerLoop() {
+    long long seen = 0;
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        wakeUp.wait(lock, [this, seen] { return stopped || generation != seen; });
+        if (stopped) {
+          return;
+        }
+        seen = generation;
+      }
+
+      drain();
+
+      std::lock_guard<std::mutex> lock(mutex);
+      if (--active == 0) {
+        finished.notify_one();
+      }
+    }
+  }
+};
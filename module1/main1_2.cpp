@@ -1,4 +1,24 @@
 #include <iostream>
+#include <sstream>
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <memory>
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SHOELACE_X86
+#include <immintrin.h>
+#endif
+
+#include "../common/FastInput.h"
+#include "../common/ThreadPool.h"
+
+#define AREA_CHUNK_SIZE (1 << 16)
+#define QUERY_BLOCK_SIZE 4096
 
 /* Вычислить площадь выпуклого n-угольника, заданного координатами своих вершин.
  * Вначале вводится количество вершин, затем последовательно целочисленные координаты
@@ -16,26 +36,609 @@ struct Point {
   int y;
 };
 
-void run(std::istream &is, std::ostream &os) {
+// Вклад ребра (a, b) в удвоенную ориентированную площадь
+int64_t cross(const Point &a, const Point &b) {
+  return static_cast<int64_t>(a.x) * b.y - static_cast<int64_t>(b.x) * a.y;
+}
+
+// Вершины хранятся структурой массивов, последняя вершина дублирует первую,
+// чтобы ребро (n - 1, 0) считалось без взятия по модулю.
+class Polygon {
+ public:
+  explicit Polygon(int count)
+      : count(count), x(new int[count + 1]), y(new int[count + 1]) {
+  }
+
+  ~Polygon() {
+    delete[] x;
+    delete[] y;
+  }
+
+  int size() const {
+    return count;
+  }
+
+  Point get(int i) const {
+    return Point(x[i], y[i]);
+  }
+
+  void set(int i, const Point &point) {
+    x[i] = point.x;
+    y[i] = point.y;
+    if (i == 0) {
+      x[count] = point.x;
+      y[count] = point.y;
+    }
+  }
+
+  const int *xs() const {
+    return x;
+  }
+
+  const int *ys() const {
+    return y;
+  }
+
+  Polygon(const Polygon &other) = delete;
+  Polygon(Polygon &&other) = delete;
+  Polygon &operator=(const Polygon &other) = delete;
+  Polygon &operator=(Polygon &&other) = delete;
+
+ private:
   int count;
+  int *x;
+  int *y;
+};
+
+// Удвоенная ориентированная площадь рёбер [from, to): сумма x[i] * y[i + 1] - x[i + 1] * y[i]
+int64_t shoelaceScalar(const int *x, const int *y, int from, int to) {
+  int64_t sum = 0;
+  for (int i = from; i < to; ++i) {
+    sum += static_cast<int64_t>(x[i]) * y[i + 1] - static_cast<int64_t>(x[i + 1]) * y[i];
+  }
+
+  return sum;
+}
+
+#ifdef SHOELACE_X86
+__attribute__((target("sse4.1")))
+int64_t shoelaceSse41(const int *x, const int *y, int from, int to) {
+  __m128i acc = _mm_setzero_si128();
+  int i = from;
+  for (; i + 2 <= to; i += 2) {
+    // _mm_mul_epi32 перемножает младшие 32 бита каждой 64-битной ячейки со знаком
+    __m128i xi = _mm_cvtepi32_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(x + i)));
+    __m128i yi = _mm_cvtepi32_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(y + i)));
+    __m128i xj = _mm_cvtepi32_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(x + i + 1)));
+    __m128i yj = _mm_cvtepi32_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(y + i + 1)));
+    acc = _mm_add_epi64(acc, _mm_sub_epi64(_mm_mul_epi32(xi, yj), _mm_mul_epi32(xj, yi)));
+  }
+
+  int64_t lanes[2];
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), acc);
+  return lanes[0] + lanes[1] + shoelaceScalar(x, y, i, to);
+}
+
+__attribute__((target("avx2")))
+int64_t shoelaceAvx2(const int *x, const int *y, int from, int to) {
+  __m256i acc = _mm256_setzero_si256();
+  int i = from;
+  for (; i + 4 <= to; i += 4) {
+    __m256i xi = _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i *>(x + i)));
+    __m256i yi = _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i *>(y + i)));
+    __m256i xj = _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i *>(x + i + 1)));
+    __m256i yj = _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i *>(y + i + 1)));
+    acc = _mm256_add_epi64(acc, _mm256_sub_epi64(_mm256_mul_epi32(xi, yj), _mm256_mul_epi32(xj, yi)));
+  }
+
+  int64_t lanes[4];
+  _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), acc);
+  return lanes[0] + lanes[1] + lanes[2] + lanes[3] + shoelaceScalar(x, y, i, to);
+}
+#endif
+
+typedef int64_t (*ShoelaceKernel)(const int *x, const int *y, int from, int to);
+
+ShoelaceKernel selectShoelaceKernel() {
+#ifdef SHOELACE_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return shoelaceAvx2;
+  }
+  if (__builtin_cpu_supports("sse4.1")) {
+    return shoelaceSse41;
+  }
+#endif
+  return shoelaceScalar;
+}
+
+int64_t doubledArea(const Polygon &polygon, int from, int to) {
+  static const ShoelaceKernel kernel = selectShoelaceKernel();
+  return kernel(polygon.xs(), polygon.ys(), from, to);
+}
+
+int64_t doubledArea(const Polygon &polygon) {
+  return doubledArea(polygon, 0, polygon.size());
+}
+
+// Площадь по удвоенной точно, без double: половина модуля и ".5" для нечётного
+void printArea(std::ostream &os, int64_t doubled) {
+  uint64_t magnitude = doubled < 0 ? 0 - static_cast<uint64_t>(doubled) : static_cast<uint64_t>(doubled);
+  os << magnitude / 2;
+  if (magnitude % 2 != 0) {
+    os << ".5";
+  }
+}
+
+struct AreaTask {
+  int polygon;
+  int from;
+  int to;
+};
+
+// Большие многоугольники режутся на куски по AREA_CHUNK_SIZE рёбер, частичные суммы
+// складываются в int64, поэтому результат не зависит от числа потоков
+std::vector<int64_t> doubledAreas(const std::vector<std::unique_ptr<Polygon>> &polygons, ThreadPool &pool) {
+  std::vector<AreaTask> tasks;
+  for (size_t i = 0; i < polygons.size(); ++i) {
+    int size = polygons[i]->size();
+    for (int from = 0; from < size; from += AREA_CHUNK_SIZE) {
+      tasks.push_back({static_cast<int>(i), from, std::min(from + AREA_CHUNK_SIZE, size)});
+    }
+  }
+
+  std::vector<int64_t> partial(tasks.size());
+  pool.parallelFor(static_cast<int>(tasks.size()), [&](int i) {
+    partial[i] = doubledArea(*polygons[tasks[i].polygon], tasks[i].from, tasks[i].to);
+  });
+
+  std::vector<int64_t> result(polygons.size(), 0);
+  for (size_t i = 0; i < tasks.size(); ++i) {
+    result[tasks[i].polygon] += partial[i];
+  }
+
+  return result;
+}
+
+// Пакетный режим: на входе подряд идут многоугольники, каждый со своим числом вершин
+template<typename Input>
+void runBatch(Input &is, std::ostream &os, ThreadPool &pool) {
+  std::vector<std::unique_ptr<Polygon>> polygons;
+  int count;
+  while (is >> count) {
+    std::unique_ptr<Polygon> polygon(new Polygon(count));
+    for (int i = 0; i < count; ++i) {
+      Point point;
+      is >> point.x >> point.y;
+      polygon->set(i, point);
+    }
+    polygons.push_back(std::move(polygon));
+  }
+
+  for (int64_t area : doubledAreas(polygons, pool)) {
+    printArea(os, area);
+    os << '\n';
+  }
+}
+
+void runBatch(const char *begin, const char *end, std::ostream &os, ThreadPool &pool) {
+  InputReader reader(begin, end);
+  runBatch(reader, os, pool);
+}
+
+// Потоковый подсчёт: хранит только первую и предыдущую вершины
+class ShoelaceAccumulator {
+ public:
+  ShoelaceAccumulator()
+      : sum(0), count(0) {
+  }
+
+  void add(const Point &point) {
+    if (count == 0) {
+      first = point;
+    } else {
+      sum += cross(previous, point);
+    }
+
+    previous = point;
+    ++count;
+  }
+
+  int64_t doubledArea() const {
+    return count == 0 ? 0 : sum + cross(previous, first);
+  }
+
+ private:
+  int64_t sum;
+  int64_t count;
+  Point first;
+  Point previous;
+};
+
+template<typename Input>
+void runStreaming(Input &is, std::ostream &os) {
+  int64_t count;
   is >> count;
-  auto *pointsArray = new Point[count];
-  for (int i = 0; i < count; ++i) {
-    is >> pointsArray[i].x >> pointsArray[i].y;
+  ShoelaceAccumulator accumulator;
+  for (int64_t i = 0; i < count; ++i) {
+    Point point;
+    is >> point.x >> point.y;
+    accumulator.add(point);
   }
 
-  double square = 0;
+  printArea(os, accumulator.doubledArea());
+}
+
+void runStreaming(const char *begin, const char *end, std::ostream &os) {
+  InputReader reader(begin, end);
+  runStreaming(reader, os);
+}
+
+template<typename Input>
+void run(Input &is, std::ostream &os) {
+  int count;
+  is >> count;
+  Polygon polygon(count);
   for (int i = 0; i < count; ++i) {
-    int j = (i + 1) % count;
-    square += (pointsArray[i].y + pointsArray[j].y) / 2.0 * (pointsArray[i].x - pointsArray[j].x);
+    Point point;
+    is >> point.x >> point.y;
+    polygon.set(i, point);
   }
 
-  os << std::abs(square);
+  printArea(os, doubledArea(polygon));
+}
+
+void run(const char *begin, const char *end, std::ostream &os) {
+  InputReader reader(begin, end);
+  run(reader, os);
+}
+
+// Многоугольник, который меняется по одной вершине. Вершины образуют кольцевой
+// двусвязный список, площадь пересчитывается только по затронутым рёбрам за O(1).
+class DynamicPolygon {
+ public:
+  struct Vertex {
+    explicit Vertex(const Point &point)
+        : point(point), prev(this), next(this) {
+    }
+
+    Point point;
+    Vertex *prev;
+    Vertex *next;
+  };
+
+  DynamicPolygon()
+      : head(nullptr), count(0), sum(0) {
+  }
+
+  ~DynamicPolygon() {
+    while (head) {
+      erase(head);
+    }
+  }
+
+  // Вставляет вершину после vertex. nullptr - вставка в конец обхода (после последней вершины),
+  // в пустом многоугольнике новая вершина становится первой
+  Vertex *insertAfter(Vertex *vertex, const Point &point) {
+    auto *node = new Vertex(point);
+    ++count;
+    if (!head) {
+      head = node;
+      return node;
+    }
+    if (!vertex) {
+      vertex = head->prev;
+    }
+
+    Vertex *next = vertex->next;
+    sum += cross(vertex->point, point) + cross(point, next->point) - cross(vertex->point, next->point);
+    node->prev = vertex;
+    node->next = next;
+    vertex->next = node;
+    next->prev = node;
+    return node;
+  }
+
+  void erase(Vertex *vertex) {
+    Vertex *prev = vertex->prev;
+    Vertex *next = vertex->next;
+    sum += cross(prev->point, next->point) - cross(prev->point, vertex->point) - cross(vertex->point, next->point);
+    prev->next = next;
+    next->prev = prev;
+    if (head == vertex) {
+      head = next == vertex ? nullptr : next;
+    }
+
+    delete vertex;
+    --count;
+  }
+
+  void move(Vertex *vertex, const Point &point) {
+    Vertex *prev = vertex->prev;
+    Vertex *next = vertex->next;
+    sum -= cross(prev->point, vertex->point) + cross(vertex->point, next->point);
+    vertex->point = point;
+    sum += cross(prev->point, vertex->point) + cross(vertex->point, next->point);
+  }
+
+  Vertex *first() const {
+    return head;
+  }
+
+  int size() const {
+    return count;
+  }
+
+  int64_t doubledArea() const {
+    return sum;
+  }
+
+  double area() const {
+    return std::llabs(sum) / 2.0;
+  }
+
+  DynamicPolygon(const DynamicPolygon &other) = delete;
+  DynamicPolygon(DynamicPolygon &&other) = delete;
+  DynamicPolygon &operator=(const DynamicPolygon &other) = delete;
+  DynamicPolygon &operator=(DynamicPolygon &&other) = delete;
+
+ private:
+  Vertex *head;
+  int count;
+  int64_t sum;
+};
+
+enum class Location {
+  Outside,
+  Boundary,
+  Inside
+};
+
+// Проверка принадлежности точки выпуклому многоугольнику (вершины против часовой стрелки, n >= 3)
+// за O(log n): из вершины 0 строится веер лучей, бинарным поиском находится сектор с точкой,
+// затем точка проверяется относительно противолежащего ребра.
+class ConvexPolygonLocator {
+ public:
+  ConvexPolygonLocator(const Point *points, int count)
+      : pivot(points[0]), rayX(count), rayY(count) {
+    for (int i = 0; i < count; ++i) {
+      rayX[i] = static_cast<int64_t>(points[i].x) - pivot.x;
+      rayY[i] = static_cast<int64_t>(points[i].y) - pivot.y;
+    }
+  }
+
+  Location locate(const Point &point) const {
+    int n = static_cast<int>(rayX.size());
+    int64_t qx = static_cast<int64_t>(point.x) - pivot.x;
+    int64_t qy = static_cast<int64_t>(point.y) - pivot.y;
+
+    int64_t first = rayCross(1, qx, qy);
+    int64_t last = rayCross(n - 1, qx, qy);
+    if (first < 0 || last > 0) {
+      return Location::Outside;
+    }
+    if (first == 0) {
+      return onRay(1, qx, qy) ? Location::Boundary : Location::Outside;
+    }
+    if (last == 0) {
+      return onRay(n - 1, qx, qy) ? Location::Boundary : Location::Outside;
+    }
+
+    int left = 1;
+    int right = n - 1;
+    while (right - left > 1) {
+      int mid = (left + right) / 2;
+      if (rayCross(mid, qx, qy) >= 0) {
+        left = mid;
+      } else {
+        right = mid;
+      }
+    }
+
+    int64_t edge = (rayX[left + 1] - rayX[left]) * (qy - rayY[left]) - (rayY[left + 1] - rayY[left]) * (qx - rayX[left]);
+    if (edge < 0) {
+      return Location::Outside;
+    }
+
+    return edge == 0 ? Location::Boundary : Location::Inside;
+  }
 
-  delete[] pointsArray;
+  // Запросы сортируются по углу относительно опорной вершины, чтобы соседние бинарные поиски
+  // шли по одним и тем же лучам; блоки отсортированных запросов обрабатываются параллельно.
+  void locateBatch(const Point *queries, int count, Location *result, ThreadPool &pool) const {
+    std::vector<std::pair<double, int>> order(count);
+    for (int i = 0; i < count; ++i) {
+      order[i] = {pseudoAngle(queries[i]), i};
+    }
+    std::sort(order.begin(), order.end());
+
+    int blocks = (count + QUERY_BLOCK_SIZE - 1) / QUERY_BLOCK_SIZE;
+    pool.parallelFor(blocks, [&](int block) {
+      int to = std::min(count, (block + 1) * QUERY_BLOCK_SIZE);
+      for (int i = block * QUERY_BLOCK_SIZE; i < to; ++i) {
+        result[order[i].second] = locate(queries[order[i].second]);
+      }
+    });
+  }
+
+ private:
+  Point pivot;
+  std::vector<int64_t> rayX;
+  std::vector<int64_t> rayY;
+
+  int64_t rayCross(int i, int64_t qx, int64_t qy) const {
+    return rayX[i] * qy - rayY[i] * qx;
+  }
+
+  // Точка уже лежит на прямой луча i; проверяем, что она внутри отрезка
+  bool onRay(int i, int64_t qx, int64_t qy) const {
+    int64_t dot = rayX[i] * qx + rayY[i] * qy;
+    return dot >= 0 && dot <= rayX[i] * rayX[i] + rayY[i] * rayY[i];
+  }
+
+  // Монотонная по углу замена atan2 со значениями в [0, 4)
+  double pseudoAngle(const Point &point) const {
+    double dx = static_cast<double>(point.x) - pivot.x;
+    double dy = static_cast<double>(point.y) - pivot.y;
+    double sum = std::abs(dx) + std::abs(dy);
+    if (sum == 0) {
+      return 0;
+    }
+
+    double p = dx / sum;
+    return dy < 0 ? 3 + p : 1 - p;
+  }
+};
+
+// Положение точки относительно шестиугольника из test(), посчитанное напрямую по его сторонам
+Location hexagonLocation(const Point &q) {
+  bool inside = q.y > 0 && q.y < 4 && q.x + q.y > 0 && q.x - q.y < 4 && q.x + q.y < 8 && q.y - q.x < 4;
+  bool outside = q.y < 0 || q.y > 4 || q.x + q.y < 0 || q.x - q.y > 4 || q.x + q.y > 8 || q.y - q.x > 4;
+  return inside ? Location::Inside : outside ? Location::Outside : Location::Boundary;
+}
+
+void test() {
+  {
+    std::stringstream input;
+    std::stringstream output;
+
+    input << "4" << std::endl;
+    input << "0 1 1 0 2 1 1 2" << std::endl;
+
+    run(input, output);
+
+    assert(output.str() == "2");
+  }
+  {
+    std::stringstream input;
+    std::stringstream output;
+
+    input << "3" << std::endl;
+    input << "0 0 3 0 0 3" << std::endl;
+
+    run(input, output);
+
+    assert(output.str() == "4.5");
+  }
+  {
+    std::stringstream input;
+    std::stringstream output;
+
+    input << "4 0 0 12345 0 12345 10001 0 10001" << std::endl;
+
+    run(input, output);
+
+    assert(output.str() == "123462345");
+  }
+  {
+    Polygon polygon(1001);
+    for (int i = 0; i < polygon.size(); ++i) {
+      polygon.set(i, Point(std::rand() % 20001 - 10000, std::rand() % 20001 - 10000));
+    }
+
+    assert(doubledArea(polygon) == shoelaceScalar(polygon.xs(), polygon.ys(), 0, polygon.size()));
+  }
+  {
+    std::string input = "5\n-3 -2 4 -1 5 3 0 6 -4 2\n";
+    std::stringstream batchOutput;
+    std::stringstream streamOutput;
+
+    run(input.data(), input.data() + input.size(), batchOutput);
+    runStreaming(input.data(), input.data() + input.size(), streamOutput);
+
+    assert(batchOutput.str() == streamOutput.str());
+  }
+  {
+    std::stringstream input;
+    std::stringstream expected;
+    int bigCount = 3 * AREA_CHUNK_SIZE + 7;
+    input << bigCount << std::endl;
+    std::stringstream bigPolygon;
+    bigPolygon << bigCount << std::endl;
+    for (int i = 0; i < bigCount; ++i) {
+      int x = std::rand() % 20001 - 10000;
+      int y = std::rand() % 20001 - 10000;
+      input << x << " " << y << std::endl;
+      bigPolygon << x << " " << y << std::endl;
+    }
+    run(bigPolygon, expected);
+    expected << '\n';
+    input << "4 0 1 1 0 2 1 1 2" << std::endl;
+    input << "3 0 0 3 0 0 3" << std::endl;
+    expected << "2\n4.5\n";
+
+    std::stringstream output;
+    ThreadPool pool(4);
+    runBatch(input, output, pool);
+
+    assert(output.str() == expected.str());
+  }
+  {
+    DynamicPolygon polygon;
+    std::vector<DynamicPolygon::Vertex *> vertices;
+    for (int step = 0; step < 2000; ++step) {
+      int action = vertices.empty() ? 0 : std::rand() % 3;
+      Point point(std::rand() % 20001 - 10000, std::rand() % 20001 - 10000);
+      int index = vertices.empty() ? 0 : std::rand() % static_cast<int>(vertices.size());
+      if (action == 0) {
+        bool append = vertices.empty() || std::rand() % 4 == 0;
+        vertices.push_back(polygon.insertAfter(append ? nullptr : vertices[index], point));
+      } else if (action == 1) {
+        polygon.erase(vertices[index]);
+        vertices.erase(vertices.begin() + index);
+      } else {
+        polygon.move(vertices[index], point);
+      }
+
+      ShoelaceAccumulator accumulator;
+      auto *vertex = polygon.first();
+      for (int i = 0; i < polygon.size(); ++i, vertex = vertex->next) {
+        accumulator.add(vertex->point);
+      }
+      assert(polygon.doubledArea() == accumulator.doubledArea());
+    }
+  }
+  {
+    DynamicPolygon polygon;
+    polygon.insertAfter(nullptr, Point(0, 0));
+    polygon.insertAfter(nullptr, Point(4, 0));
+    polygon.insertAfter(nullptr, Point(4, 3));
+    polygon.insertAfter(nullptr, Point(0, 3));
+    assert(polygon.size() == 4 && polygon.doubledArea() == 24);
+    assert(polygon.first()->point.x == 0 && polygon.first()->prev->point.y == 3);
+  }
+  {
+    Point hexagon[] = {Point(0, 0), Point(4, 0), Point(6, 2), Point(4, 4), Point(0, 4), Point(-2, 2)};
+    ConvexPolygonLocator locator(hexagon, 6);
+    assert(locator.locate(Point(2, 2)) == Location::Inside);
+    assert(locator.locate(Point(0, 0)) == Location::Boundary);
+    assert(locator.locate(Point(2, 0)) == Location::Boundary);
+    assert(locator.locate(Point(5, 3)) == Location::Boundary);
+    assert(locator.locate(Point(-1, 3)) == Location::Boundary);
+    assert(locator.locate(Point(0, 2)) == Location::Inside);
+    assert(locator.locate(Point(6, 0)) == Location::Outside);
+    assert(locator.locate(Point(-2, 0)) == Location::Outside);
+    assert(locator.locate(Point(5, 0)) == Location::Outside);
+    assert(locator.locate(Point(0, 5)) == Location::Outside);
+
+    std::vector<Point> queries;
+    for (int x = -4; x <= 8; ++x) {
+      for (int y = -2; y <= 6; ++y) {
+        queries.push_back(Point(x, y));
+      }
+    }
+    std::vector<Location> result(queries.size());
+    ThreadPool pool(2);
+    locator.locateBatch(queries.data(), static_cast<int>(queries.size()), result.data(), pool);
+    for (size_t i = 0; i < queries.size(); ++i) {
+      assert(result[i] == locator.locate(queries[i]));
+      assert(result[i] == hexagonLocation(queries[i]));
+    }
+  }
 }
 
 int main() {
+//  test();
   run(std::cin, std::cout);
 
   return 0;
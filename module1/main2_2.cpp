@@ -1,6 +1,18 @@
 #include <iostream>
 #include <cassert>
 #include <sstream>
+#include <vector>
+#include <algorithm>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "../common/FastInput.h"
+#include "../common/ThreadPool.h"
+
+#define SIMD_TAIL_SIZE 16
+#define BATCH_BLOCK_SIZE 1024
 
 /* Дан массив целых чисел А[0..n-1]. Известно, что на интервале [0, m]
  * значения массива строго возрастают, а на интервале [m, n-1] строго убывают.
@@ -8,9 +20,10 @@
  * Требования:  Время работы O(log m). Внимание! В этой задаче сначала нужно
  * определить диапазон для бинарного поиска размером порядка m, а потом уже в нем делать бинарный поиск. */
 
-int binarySearch(const int *array, int left, int right) {
+template<typename Index>
+Index binarySearch(const int *array, Index left, Index right) {
   while (left < right) {
-    int mid = (left + right) / 2;
+    Index mid = left + (right - left) / 2;
 
     if (array[mid] > array[mid + 1]) {
       right = mid;
@@ -22,8 +35,9 @@ int binarySearch(const int *array, int left, int right) {
   return left;
 }
 
-int exponentialSearch(const int *array, int n) {
-  int i = 1;
+template<typename Index>
+Index exponentialSearch(const int *array, Index n) {
+  Index i = 1;
   while (i < n && array[i - 1] < array[i]) {
     i *= 2;
   }
@@ -31,7 +45,8 @@ int exponentialSearch(const int *array, int n) {
   return binarySearch(array, i / 2, std::min(i, n - 1));
 }
 
-void run(std::istream &is, std::ostream &os) {
+template<typename Input>
+void run(Input &is, std::ostream &os) {
   int count = 0;
   is >> count;
   int *array = new int[count];
@@ -44,6 +59,86 @@ void run(std::istream &is, std::ostream &os) {
   delete[] array;
 }
 
+void run(const char *begin, const char *end, std::ostream &os) {
+  InputReader reader(begin, end);
+  run(reader, os);
+}
+
+// Первый спуск в окне [left, right]: индекс первого i с array[i] > array[i + 1], иначе right.
+// Четыре соседние пары сравниваются одной командой вместо ветвящегося деления пополам.
+template<typename Index>
+Index peakScan(const int *array, Index left, Index right) {
+#ifdef __SSE2__
+  for (; left + 4 <= right; left += 4) {
+    __m128i current = _mm_loadu_si128(reinterpret_cast<const __m128i *>(array + left));
+    __m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i *>(array + left + 1));
+    int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(current, next)));
+    if (mask != 0) {
+      return left + __builtin_ctz(mask);
+    }
+  }
+#endif
+  for (; left < right; ++left) {
+    if (array[left] > array[left + 1]) {
+      return left;
+    }
+  }
+
+  return right;
+}
+
+// То же, что exponentialSearch, но окно меньше SIMD_TAIL_SIZE досматривается peakScan
+template<typename Index>
+Index exponentialSearchTail(const int *array, Index n) {
+  Index i = 1;
+  while (i < n && array[i - 1] < array[i]) {
+    i *= 2;
+  }
+
+  Index left = i / 2;
+  Index right = std::min(i, n - 1);
+  while (right - left > SIMD_TAIL_SIZE) {
+    Index mid = left + (right - left) / 2;
+
+    if (array[mid] > array[mid + 1]) {
+      right = mid;
+    } else {
+      left = mid + 1;
+    }
+  }
+
+  return peakScan(array, left, right);
+}
+
+// Пакет массивов в одном буфере: массив j занимает values[offsets[j]..offsets[j + 1]).
+// В result[j] пишется индекс вершины внутри массива j; блоки массивов раздаются потокам.
+void exponentialSearchBatch(const int *values, const long long *offsets, int arrays, long long *result, ThreadPool &pool) {
+  int blocks = (arrays + BATCH_BLOCK_SIZE - 1) / BATCH_BLOCK_SIZE;
+  pool.parallelFor(blocks, [&](int block) {
+    int to = std::min(arrays, (block + 1) * BATCH_BLOCK_SIZE);
+    for (int j = block * BATCH_BLOCK_SIZE; j < to; ++j) {
+      result[j] = exponentialSearchTail(values + offsets[j], offsets[j + 1] - offsets[j]);
+    }
+  });
+}
+
+// Поиск по бинарному файлу из значений int, отображённому в память. Файл не читается
+// целиком: галоп и бинарный поиск касаются O(log m) страниц, а MADV_RANDOM отключает
+// упреждающее чтение соседних страниц.
+long long exponentialSearchMapped(const char *path) {
+  MappedInput input(path, MADV_RANDOM);
+  long long count = (input.end() - input.begin()) / static_cast<long long>(sizeof(int));
+  if (count == 0) {
+    return -1;
+  }
+
+  return exponentialSearch(reinterpret_cast<const int *>(input.begin()), count);
+}
+
+void runMapped(const char *path, std::ostream &os) {
+  os << exponentialSearchMapped(path) << std::endl;
+}
+
 void test() {
   {
     std::stringstream input;
@@ -67,10 +162,59 @@ void test() {
 
     assert(output.str() == "5\n");
   }
+  {
+    char path[] = "/tmp/bitonicXXXXXX";
+    int fd = mkstemp(path);
+    assert(fd != -1);
+    std::vector<int> array;
+    for (int i = 0; i < 100000; ++i) {
+      array.push_back(i);
+    }
+    for (int i = 0; i < 1000; ++i) {
+      array.push_back(-i);
+    }
+    ssize_t written = write(fd, array.data(), array.size() * sizeof(int));
+    close(fd);
+    assert(written == static_cast<ssize_t>(array.size() * sizeof(int)));
+    (void) written;
+
+    std::stringstream output;
+    runMapped(path, output);
+    unlink(path);
+
+    assert(output.str() == "99999\n");
+    assert(exponentialSearchMapped("/nonexistent/bitonic") == -1);
+  }
+  {
+    std::vector<int> values;
+    std::vector<long long> offsets = {0};
+    std::vector<long long> expected;
+    for (int length = 1; length < 300; ++length) {
+      for (int peak = 0; peak < length; peak += 1 + peak / 8) {
+        size_t start = values.size();
+        for (int i = 0; i < length; ++i) {
+          values.push_back(i <= peak ? i : 2 * peak - i);
+        }
+        offsets.push_back(values.size());
+        expected.push_back(exponentialSearch(values.data() + start, static_cast<long long>(length)));
+        assert(expected.back() == peak);
+      }
+    }
+
+    ThreadPool pool(2);
+    int arrays = static_cast<int>(expected.size());
+    std::vector<long long> result(arrays);
+    exponentialSearchBatch(values.data(), offsets.data(), arrays, result.data(), pool);
+    assert(result == expected);
+  }
 }
 
-int main() {
+int main(int argc, char *argv[]) {
 //  test();
+  if (argc > 1) {
+    runMapped(argv[1], std::cout);
+    return 0;
+  }
   run(std::cin, std::cout);
   return 0;
 }
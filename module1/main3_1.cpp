@@ -4,49 +4,138 @@
 #include <iostream>
 #include <sstream>
 #include <cassert>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+#include <new>
+
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "../common/FastInput.h"
+#include "../common/RawStorage.h"
+#include "../common/ShrinkPolicy.h"
 
 #define FIRST_ALLOC_SIZE 5
 #define REALLOC_SIZE 2
+#define CACHE_LINE_SIZE 64
+#define SPSC_DEFAULT_CAPACITY 1024
+#define MPMC_DEFAULT_CAPACITY 1024
+#define MPMC_SPIN_COUNT 64
+#define QUEUE_CHUNK_SIZE 1024
+#define QUEUE_SPARE_CHUNKS 4
 
 template<typename T>
 class Queue {
  public:
-  Queue()
-      : head(0), tail(0), bufferSize(0), allocSize(FIRST_ALLOC_SIZE), buffer(new T[allocSize]) {
+  explicit Queue(ShrinkPolicy shrink = ShrinkPolicy())
+      : head(0),
+        tail(0),
+        bufferSize(0),
+        allocSize(FIRST_ALLOC_SIZE),
+        buffer(allocateStorage<T>(allocSize)),
+        shrink(shrink) {
   }
 
   ~Queue() {
-    delete[] buffer;
+    int first = std::min(bufferSize, allocSize - head);
+    destroyElements(buffer + head, first);
+    destroyElements(buffer, bufferSize - first);
+    freeStorage(buffer);
   }
 
   void Push(T value) {
+    Emplace(std::move(value));
+  }
+
+  // Конструирует элемент прямо в буфере
+  template<typename... Args>
+  void Emplace(Args &&... args) {
     if (allocSize == bufferSize) {
       resize();
     }
 
-    if (bufferSize != 0) {
-      tail = (tail + 1) % allocSize;
-    }
-
-    buffer[tail] = value;
+    int next = bufferSize == 0 ? head : (tail + 1) % allocSize;
+    new(buffer + next) T(std::forward<Args>(args)...);
+    tail = next;
     bufferSize++;
   }
 
   T Pop() {
     if (isEmpty()) {
-      return -1;
+      return emptyValue<T>();
     }
 
-    T res = buffer[head];
+    T res = std::move(buffer[head]);
+    buffer[head].~T();
 
     if (bufferSize != 1) {
       head = (head + 1) % allocSize;
     }
 
     --bufferSize;
+    shrinkAfterRemove(1);
     return res;
   }
 
+  // Кладёт n элементов за раз: не больше одного расширения и двух непрерывных копирований
+  void PushN(const T *values, int n) {
+    if (n <= 0) {
+      return;
+    }
+    if (allocSize - bufferSize < n) {
+      resize(bufferSize + n);
+    }
+
+    int next = bufferSize == 0 ? head : (tail + 1) % allocSize;
+    int first = std::min(n, allocSize - next);
+    copyConstruct(buffer + next, values, first);
+    copyConstruct(buffer, values + first, n - first);
+
+    tail = (next + n - 1) % allocSize;
+    bufferSize += n;
+  }
+
+  // Достаёт до n элементов в out, возвращает сколько достал
+  int PopN(T *out, int n) {
+    int count = std::min(n, bufferSize);
+    if (count <= 0) {
+      return 0;
+    }
+
+    int first = std::min(count, allocSize - head);
+    moveOutElements(out, buffer + head, first);
+    moveOutElements(out + first, buffer, count - first);
+
+    bufferSize -= count;
+    head = bufferSize == 0 ? tail : (head + count) % allocSize;
+    shrinkAfterRemove(count);
+    return count;
+  }
+
+  // Отдаёт лишнюю память: ёмкость становится равна размеру (но не меньше FIRST_ALLOC_SIZE)
+  void ShrinkToFit() {
+    int fit = std::max(bufferSize, FIRST_ALLOC_SIZE);
+    if (fit != allocSize) {
+      reallocate(fit);
+    }
+  }
+
+  size_t ReservedBytes() const {
+    return static_cast<size_t>(allocSize) * sizeof(T);
+  }
+
+  size_t UsedBytes() const {
+    return static_cast<size_t>(bufferSize) * sizeof(T);
+  }
+
   Queue(const Queue &other) = delete;
   Queue(Queue &&other) = delete;
   Queue &operator=(const Queue &other) = delete;
@@ -58,27 +147,589 @@ class Queue {
   int bufferSize;
   int allocSize;
   T *buffer;
+  ShrinkPolicy shrink;
 
   bool isEmpty() const {
     return bufferSize == 0;
   }
 
-  void resize() {
-    allocSize *= REALLOC_SIZE;
-    auto *newBuffer = new T[allocSize];
+  void resize(int needed = 0) {
+    int newSize = allocSize;
+    do {
+      newSize *= REALLOC_SIZE;
+    } while (newSize < needed);
+    reallocate(newSize);
+  }
 
-    for (int i = 0; i < bufferSize; i++) {
-      newBuffer[i] = buffer[(head + i) % bufferSize];
+  void shrinkAfterRemove(int count) {
+    int newSize = shrink.onRemove(bufferSize, allocSize, FIRST_ALLOC_SIZE, count);
+    if (newSize != allocSize) {
+      reallocate(newSize);
     }
+  }
+
+  // Элементы переносятся в новый буфер перемещением, а не копированием
+  void reallocate(int newSize) {
+    T *newBuffer = allocateStorage<T>(newSize);
+
+    int first = std::min(bufferSize, allocSize - head);
+    relocateElements(newBuffer, buffer + head, first);
+    relocateElements(newBuffer + first, buffer, bufferSize - first);
 
     head = 0;
-    tail = bufferSize - 1;
-    delete[] buffer;
+    tail = bufferSize == 0 ? 0 : bufferSize - 1;
+    allocSize = newSize;
+    freeStorage(buffer);
     buffer = newBuffer;
+    shrink.onResize();
+  }
+};
+
+// Очередь из списка блоков фиксированного размера. При росте добавляется новый блок,
+// уже лежащие элементы не копируются, поэтому время Push не зависит от размера очереди.
+// Освободившиеся блоки (не больше QUEUE_SPARE_CHUNKS) переиспользуются через список свободных.
+// Как и в Queue, ячейки блока не конструируются заранее.
+template<typename T>
+class ChunkedQueue {
+ public:
+  ChunkedQueue()
+      : headChunk(new Chunk()), tailChunk(headChunk), headPos(0), tailPos(0), bufferSize(0),
+        freeChunks(nullptr), freeCount(0) {
+  }
+
+  ~ChunkedQueue() {
+    for (Chunk *chunk = headChunk; chunk; chunk = chunk->next) {
+      int from = chunk == headChunk ? headPos : 0;
+      int to = chunk == tailChunk ? tailPos : QUEUE_CHUNK_SIZE;
+      destroyElements(chunk->values + from, to - from);
+    }
+    deleteList(headChunk);
+    deleteList(freeChunks);
+  }
+
+  void Push(T value) {
+    if (tailPos == QUEUE_CHUNK_SIZE) {
+      appendChunk();
+    }
+
+    new(tailChunk->values + tailPos++) T(std::move(value));
+    bufferSize++;
+  }
+
+  T Pop() {
+    if (isEmpty()) {
+      return emptyValue<T>();
+    }
+
+    T res = std::move(headChunk->values[headPos]);
+    headChunk->values[headPos++].~T();
+    --bufferSize;
+    advanceHead();
+    return res;
+  }
+
+  void PushN(const T *values, int n) {
+    while (n > 0) {
+      if (tailPos == QUEUE_CHUNK_SIZE) {
+        appendChunk();
+      }
+
+      int count = std::min(n, QUEUE_CHUNK_SIZE - tailPos);
+      copyConstruct(tailChunk->values + tailPos, values, count);
+      tailPos += count;
+      bufferSize += count;
+      values += count;
+      n -= count;
+    }
+  }
+
+  int PopN(T *out, int n) {
+    int total = std::min(n, bufferSize);
+    for (int done = 0; done < total;) {
+      int available = headChunk == tailChunk ? tailPos - headPos : QUEUE_CHUNK_SIZE - headPos;
+      int count = std::min(total - done, available);
+      moveOutElements(out + done, headChunk->values + headPos, count);
+      headPos += count;
+      bufferSize -= count;
+      done += count;
+      advanceHead();
+    }
+
+    return std::max(total, 0);
+  }
+
+  ChunkedQueue(const ChunkedQueue &other) = delete;
+  ChunkedQueue(ChunkedQueue &&other) = delete;
+  ChunkedQueue &operator=(const ChunkedQueue &other) = delete;
+  ChunkedQueue &operator=(ChunkedQueue &&other) = delete;
+
+ private:
+  struct Chunk {
+    Chunk()
+        : values(allocateStorage<T>(QUEUE_CHUNK_SIZE)), next(nullptr) {
+    }
+
+    ~Chunk() {
+      freeStorage(values);
+    }
+
+    T *values;
+    Chunk *next;
+  };
+
+  Chunk *headChunk;
+  Chunk *tailChunk;
+  int headPos;
+  int tailPos;
+  int bufferSize;
+  Chunk *freeChunks;
+  int freeCount;
+
+  bool isEmpty() const {
+    return bufferSize == 0;
+  }
+
+  void appendChunk() {
+    Chunk *chunk = freeChunks;
+    if (chunk) {
+      freeChunks = chunk->next;
+      --freeCount;
+      chunk->next = nullptr;
+    } else {
+      chunk = new Chunk();
+    }
+
+    tailChunk->next = chunk;
+    tailChunk = chunk;
+    tailPos = 0;
+  }
+
+  // Прочитанный до конца блок уходит в список свободных; пустая очередь
+  // начинает заново с начала своего единственного блока
+  void advanceHead() {
+    if (bufferSize == 0 && headChunk == tailChunk) {
+      headPos = 0;
+      tailPos = 0;
+      return;
+    }
+    if (headPos < QUEUE_CHUNK_SIZE) {
+      return;
+    }
+
+    Chunk *chunk = headChunk;
+    headChunk = chunk->next;
+    headPos = 0;
+    if (freeCount < QUEUE_SPARE_CHUNKS) {
+      chunk->next = freeChunks;
+      freeChunks = chunk;
+      ++freeCount;
+    } else {
+      delete chunk;
+    }
+  }
+
+  static void deleteList(Chunk *chunk) {
+    while (chunk) {
+      Chunk *next = chunk->next;
+      delete chunk;
+      chunk = next;
+    }
+  }
+};
+
+#ifdef __linux__
+// "Волшебный" кольцевой буфер для тривиально копируемых T: одни и те же физические страницы
+// (memfd) отображены в память дважды подряд, поэтому любые bufferSize элементов, начиная
+// с head, лежат непрерывно. Читатель может разбирать записи прямо в буфере через ReadSpan
+// без склейки двух кусков. Размер отображения кратен НОК(размер страницы, sizeof(T)),
+// поэтому и вторая копия начинается на границе страницы, и элементы не режутся на стыке
+// для любого sizeof(T), а не только для делителей страницы.
+template<typename T>
+class MirroredQueue {
+  static_assert(std::is_trivially_copyable<T>::value, "MirroredQueue stores raw bytes");
+
+ public:
+  MirroredQueue()
+      : data(nullptr), allocSize(0), head(0), bufferSize(0) {
+    remap(1);
+  }
+
+  ~MirroredQueue() {
+    unmap(data, allocSize);
+  }
+
+  void Push(T value) {
+    PushN(&value, 1);
+  }
+
+  T Pop() {
+    if (bufferSize == 0) {
+      return -1;
+    }
+
+    T res = data[head];
+    Consume(1);
+    return res;
+  }
+
+  void PushN(const T *values, int n) {
+    if (n <= 0) {
+      return;
+    }
+
+    int available = 0;
+    T *span = WriteSpan(n, available);
+    std::memcpy(span, values, n * sizeof(T));
+    Commit(n);
+  }
+
+  int PopN(T *out, int n) {
+    int count = std::min(n, bufferSize);
+    if (count <= 0) {
+      return 0;
+    }
+
+    std::memcpy(out, data + head, count * sizeof(T));
+    Consume(count);
+    return count;
+  }
+
+  // Непрерывный участок под запись не меньше чем на needed элементов
+  // (при необходимости буфер растёт); available - сколько всего можно записать
+  T *WriteSpan(int needed, int &available) {
+    if (allocSize - bufferSize < needed) {
+      remap(bufferSize + needed);
+    }
+
+    available = allocSize - bufferSize;
+    return data + (head + bufferSize) % allocSize;
+  }
+
+  void Commit(int count) {
+    bufferSize += count;
+  }
+
+  // Все непрочитанные элементы одним непрерывным участком
+  const T *ReadSpan(int &available) const {
+    available = bufferSize;
+    return data + head;
+  }
+
+  void Consume(int count) {
+    bufferSize -= count;
+    head = bufferSize == 0 ? 0 : (head + count) % allocSize;
+  }
+
+  MirroredQueue(const MirroredQueue &other) = delete;
+  MirroredQueue(MirroredQueue &&other) = delete;
+  MirroredQueue &operator=(const MirroredQueue &other) = delete;
+  MirroredQueue &operator=(MirroredQueue &&other) = delete;
+
+ private:
+  T *data;
+  int allocSize;
+  int head;
+  int bufferSize;
+
+  // Новое двойное отображение вмещает не меньше needed элементов; старые данные
+  // переносятся одним memcpy, так как они и так лежат непрерывно.
+  // Размер кратен и странице, и sizeof(T), иначе вторая копия начнётся не с data + allocSize
+  void remap(int needed) {
+    size_t page = sysconf(_SC_PAGESIZE);
+    size_t a = page;
+    size_t b = sizeof(T);
+    while (b != 0) {
+      size_t rest = a % b;
+      a = b;
+      b = rest;
+    }
+    size_t unit = page / a * sizeof(T);
+    size_t bytes = allocSize == 0 ? unit : allocSize * sizeof(T) * REALLOC_SIZE;
+    while (bytes < needed * sizeof(T)) {
+      bytes *= REALLOC_SIZE;
+    }
+
+    int fd = memfd_create("MirroredQueue", 0);
+    if (fd == -1) {
+      throw std::bad_alloc();
+    }
+    if (ftruncate(fd, bytes) != 0) {
+      close(fd);
+      throw std::bad_alloc();
+    }
+
+    void *base = mmap(nullptr, 2 * bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) {
+      close(fd);
+      throw std::bad_alloc();
+    }
+    char *first = static_cast<char *>(base);
+    if (mmap(first, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED
+        || mmap(first + bytes, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED) {
+      munmap(base, 2 * bytes);
+      close(fd);
+      throw std::bad_alloc();
+    }
+    close(fd);
+
+    auto *newData = reinterpret_cast<T *>(first);
+    if (data) {
+      std::memcpy(newData, data + head, bufferSize * sizeof(T));
+      unmap(data, allocSize);
+    }
+
+    data = newData;
+    allocSize = static_cast<int>(bytes / sizeof(T));
+    head = 0;
+  }
+
+  static void unmap(T *pointer, int size) {
+    if (pointer) {
+      munmap(pointer, 2 * size * sizeof(T));
+    }
   }
 };
+#endif
+
+// Ёмкость кольцевых очередей SpscQueue и MpmcQueue: индекс в буфере берётся маской
+size_t roundUpPowerOfTwo(size_t capacity) {
+  size_t result = 1;
+  while (result < capacity) {
+    result *= 2;
+  }
+
+  return result;
+}
+
+// Очередь без блокировок для одного писателя и одного читателя. Ёмкость округляется
+// до степени двойки, поэтому индекс в буфере берётся маской. Индексы головы и хвоста
+// лежат на разных кэш-линиях, и каждая сторона помнит последнее увиденное значение
+// чужого индекса, чтобы не читать его атомарно на каждой операции.
+template<typename T>
+class SpscQueue {
+ public:
+  explicit SpscQueue(size_t capacity = SPSC_DEFAULT_CAPACITY)
+      : mask(roundUpPowerOfTwo(capacity) - 1), buffer(new T[mask + 1]), head(0), cachedTail(0), tail(0), cachedHead(0) {
+  }
+
+  ~SpscQueue() {
+    delete[] buffer;
+  }
 
-void run(std::istream &is, std::ostream &os) {
+  // Вызывается только писателем
+  bool TryPush(const T &value) {
+    size_t currentTail = tail.load(std::memory_order_relaxed);
+    if (currentTail - cachedHead > mask) {
+      cachedHead = head.load(std::memory_order_acquire);
+      if (currentTail - cachedHead > mask) {
+        return false;
+      }
+    }
+
+    buffer[currentTail & mask] = value;
+    tail.store(currentTail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Вызывается только читателем
+  bool TryPop(T &value) {
+    size_t currentHead = head.load(std::memory_order_relaxed);
+    if (currentHead == cachedTail) {
+      cachedTail = tail.load(std::memory_order_acquire);
+      if (currentHead == cachedTail) {
+        return false;
+      }
+    }
+
+    value = buffer[currentHead & mask];
+    head.store(currentHead + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Как Queue::Push, но при заполненном буфере ждёт читателя
+  void Push(T value) {
+    while (!TryPush(value)) {
+      std::this_thread::yield();
+    }
+  }
+
+  // Как Queue::Pop: -1, если очередь пуста
+  T Pop() {
+    T value;
+    if (!TryPop(value)) {
+      return -1;
+    }
+
+    return value;
+  }
+
+  SpscQueue(const SpscQueue &other) = delete;
+  SpscQueue(SpscQueue &&other) = delete;
+  SpscQueue &operator=(const SpscQueue &other) = delete;
+  SpscQueue &operator=(SpscQueue &&other) = delete;
+
+ private:
+  const size_t mask;
+  T *const buffer;
+
+  alignas(CACHE_LINE_SIZE) std::atomic<size_t> head;
+  size_t cachedTail;
+
+  alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail;
+  size_t cachedHead;
+};
+
+// Ограниченная очередь для многих писателей и читателей (схема Вьюкова). У каждой ячейки
+// свой счётчик sequence: ячейка свободна для записи с позицией pos, когда sequence == pos,
+// и готова к чтению, когда sequence == pos + 1. Потоки соревнуются только за CAS позиции
+// своей стороны, поэтому писатели не мешают читателям.
+template<typename T>
+class MpmcQueue {
+ public:
+  explicit MpmcQueue(size_t capacity = MPMC_DEFAULT_CAPACITY)
+      : mask(roundUpPowerOfTwo(capacity) - 1), cells(new Cell[mask + 1]), enqueuePos(0), dequeuePos(0) {
+    for (size_t i = 0; i <= mask; ++i) {
+      cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  ~MpmcQueue() {
+    delete[] cells;
+  }
+
+  bool TryPush(const T &value) {
+    size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    while (true) {
+      Cell &cell = cells[pos & mask];
+      size_t sequence = cell.sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+      if (diff == 0) {
+        if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          cell.value = value;
+          cell.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = enqueuePos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  bool TryPop(T &value) {
+    size_t pos = dequeuePos.load(std::memory_order_relaxed);
+    while (true) {
+      Cell &cell = cells[pos & mask];
+      size_t sequence = cell.sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1);
+      if (diff == 0) {
+        if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          value = cell.value;
+          cell.sequence.store(pos + mask + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = dequeuePos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Ждёт свободного места
+  void Push(const T &value) {
+    for (int spin = 0; !TryPush(value); ++spin) {
+      backoff(spin);
+    }
+  }
+
+  // Ждёт элемента
+  T Pop() {
+    T value;
+    for (int spin = 0; !TryPop(value); ++spin) {
+      backoff(spin);
+    }
+
+    return value;
+  }
+
+  template<typename Rep, typename Period>
+  bool TryPushFor(const T &value, const std::chrono::duration<Rep, Period> &timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    for (int spin = 0; !TryPush(value); ++spin) {
+      if (std::chrono::steady_clock::now() >= deadline) {
+        return false;
+      }
+      backoff(spin);
+    }
+
+    return true;
+  }
+
+  template<typename Rep, typename Period>
+  bool TryPopFor(T &value, const std::chrono::duration<Rep, Period> &timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    for (int spin = 0; !TryPop(value); ++spin) {
+      if (std::chrono::steady_clock::now() >= deadline) {
+        return false;
+      }
+      backoff(spin);
+    }
+
+    return true;
+  }
+
+  MpmcQueue(const MpmcQueue &other) = delete;
+  MpmcQueue(MpmcQueue &&other) = delete;
+  MpmcQueue &operator=(const MpmcQueue &other) = delete;
+  MpmcQueue &operator=(MpmcQueue &&other) = delete;
+
+ private:
+  struct Cell {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  const size_t mask;
+  Cell *const cells;
+
+  alignas(CACHE_LINE_SIZE) std::atomic<size_t> enqueuePos;
+  alignas(CACHE_LINE_SIZE) std::atomic<size_t> dequeuePos;
+
+  static void backoff(int spin) {
+    if (spin >= MPMC_SPIN_COUNT) {
+      std::this_thread::yield();
+    }
+  }
+};
+
+// Обычная Queue под мьютексом - с ней сравниваются SpscQueue и MpmcQueue в benchmark()
+template<typename T>
+class LockedQueue {
+ public:
+  void Push(T value) {
+    std::lock_guard<std::mutex> lock(mutex);
+    queue.Push(value);
+  }
+
+  T Pop() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return queue.Pop();
+  }
+
+  bool TryPop(T &value) {
+    value = Pop();
+    return value != -1;
+  }
+
+ private:
+  std::mutex mutex;
+  Queue<T> queue;
+};
+
+template<typename Input>
+void run(Input &is, std::ostream &os) {
   int n = 0;
   is >> n;
   Queue<int> queue;
@@ -111,6 +762,83 @@ void run(std::istream &is, std::ostream &os) {
   os << "YES" << std::endl;
 }
 
+void run(const char *begin, const char *end, std::ostream &os) {
+  InputReader reader(begin, end);
+  run(reader, os);
+}
+
+// Случайные PushN/PopN/Push/Pop пачками до maxBatch элементов сверяются с std::vector
+template<typename QueueType>
+void testBulkQueue(int maxBatch, int steps) {
+  QueueType queue;
+  std::vector<int> expected;
+  int next = 0;
+  for (int step = 0; step < steps; ++step) {
+    int n = std::rand() % maxBatch;
+    if (std::rand() % 2) {
+      std::vector<int> values(n);
+      for (auto &value : values) {
+        value = next++;
+      }
+      if (n == 1) {
+        queue.Push(values[0]);
+      } else {
+        queue.PushN(values.data(), n);
+      }
+      expected.insert(expected.end(), values.begin(), values.end());
+    } else {
+      std::vector<int> out(n);
+      int got = 0;
+      if (n != 1) {
+        got = queue.PopN(out.data(), n);
+      } else if (!expected.empty()) {
+        out[0] = queue.Pop();
+        got = 1;
+      }
+      assert(got == std::min(n, static_cast<int>(expected.size())));
+      for (int i = 0; i < got; ++i) {
+        assert(out[i] == expected[i]);
+      }
+      expected.erase(expected.begin(), expected.begin() + got);
+    }
+  }
+  while (!expected.empty()) {
+    assert(queue.Pop() == expected.front());
+    expected.erase(expected.begin());
+  }
+  assert(queue.Pop() == -1);
+}
+
+// Считает конструирования по умолчанию и копирования, чтобы видеть работу памяти очереди
+struct Counted {
+  Counted()
+      : value(0) {
+    ++defaults;
+  }
+
+  Counted(int value)
+      : value(value) {
+  }
+
+  Counted(const Counted &other)
+      : value(other.value) {
+    ++copies;
+  }
+
+  Counted &operator=(const Counted &other) {
+    value = other.value;
+    ++copies;
+    return *this;
+  }
+
+  int value;
+  static int defaults;
+  static int copies;
+};
+
+int Counted::defaults = 0;
+int Counted::copies = 0;
+
 void test() {
   {
     std::stringstream input;
@@ -149,10 +877,365 @@ void test() {
 
     assert(output.str() == "NO\n");
   }
+  testBulkQueue<Queue<int>>(40, 1000);
+  testBulkQueue<ChunkedQueue<int>>(3000, 3000);
+  {
+    // Рост ChunkedQueue не копирует уже лежащие элементы: каждый Push копирует ровно один раз,
+    // а ячейки новых блоков не конструируются по умолчанию
+    ChunkedQueue<Counted> queue;
+    Counted::defaults = 0;
+    Counted::copies = 0;
+    for (int i = 0; i < 20 * QUEUE_CHUNK_SIZE; ++i) {
+      queue.Push(Counted(i));
+    }
+    assert(Counted::copies == 20 * QUEUE_CHUNK_SIZE);
+
+    for (int i = 0; i < 20 * QUEUE_CHUNK_SIZE; ++i) {
+      queue.Pop();
+    }
+    for (int round = 0; round < 50; ++round) {
+      for (int i = 0; i < 3 * QUEUE_CHUNK_SIZE; ++i) {
+        queue.Push(Counted(i));
+      }
+      for (int i = 0; i < 3 * QUEUE_CHUNK_SIZE; ++i) {
+        assert(queue.Pop().value == i);
+      }
+    }
+    assert(Counted::defaults == 0);
+    assert(queue.Pop().value == 0 && Counted::defaults == 1);
+  }
+  {
+    // Нетривиальные T: недочитанные элементы разрушает деструктор очереди
+    ChunkedQueue<std::string> queue;
+    assert(queue.Pop().empty());
+    std::vector<std::string> values(QUEUE_CHUNK_SIZE + 7, std::string(40, 'x'));
+    queue.PushN(values.data(), static_cast<int>(values.size()));
+    for (int i = 0; i < 2 * QUEUE_CHUNK_SIZE; ++i) {
+      queue.Push(std::to_string(i));
+    }
+    std::vector<std::string> out(QUEUE_CHUNK_SIZE);
+    assert(queue.PopN(out.data(), QUEUE_CHUNK_SIZE) == QUEUE_CHUNK_SIZE && out.back() == values.back());
+    assert(queue.Pop() == values.back());
+  }
+#ifdef __linux__
+  {
+    MirroredQueue<char> queue;
+    const std::string record = "len=12;payload";
+    std::string expected;
+    for (int round = 0; round < 2000; ++round) {
+      queue.PushN(record.data(), static_cast<int>(record.size()));
+      expected += record;
+
+      int available = 0;
+      const char *span = queue.ReadSpan(available);
+      std::string unread(span, available);
+      assert(unread == expected);
+      int consumed = std::min(available, 5 + round % 20);
+      queue.Consume(consumed);
+      expected.erase(0, consumed);
+    }
+  }
+  {
+    MirroredQueue<int> queue;
+    assert(queue.Pop() == -1);
+    for (int i = 0; i < 100000; ++i) {
+      queue.Push(i);
+      if (i % 3 == 0) {
+        assert(queue.Pop() == i / 3);
+      }
+    }
+    int available = 0;
+    const int *span = queue.ReadSpan(available);
+    std::vector<int> unread(span, span + available);
+    for (size_t i = 1; i < unread.size(); ++i) {
+      assert(unread[i] == unread[i - 1] + 1);
+    }
+    queue.PushN(nullptr, 0);
+    queue.PushN(nullptr, -5);
+    assert(queue.PopN(unread.data(), available) == available);
+  }
+  {
+    // 12 байт не делят страницу: размер отображения округляется до общего кратного
+    struct Triple {
+      int a;
+      int b;
+      int c;
+    };
+    MirroredQueue<Triple> queue;
+    std::vector<Triple> out(3000);
+    for (int round = 0; round < 20; ++round) {
+      for (int i = 0; i < 1000 * (round % 3 + 1); ++i) {
+        queue.Push({round, i, -i});
+      }
+      int count = queue.PopN(out.data(), 1000 * (round % 3 + 1));
+      for (int i = 0; i < count; ++i) {
+        assert(out[i].a == round && out[i].b == i && out[i].c == -i);
+      }
+    }
+  }
+#endif
+  {
+    Queue<std::unique_ptr<int>> queue;
+    std::vector<int> expected;
+    for (int i = 0; i < 100; ++i) {
+      queue.Emplace(new int(i));
+      expected.push_back(i);
+      if (i % 2 == 0) {
+        queue.Push(std::unique_ptr<int>(new int(-i)));
+        expected.push_back(-i);
+      }
+    }
+    for (int i = 0; i < 20; ++i) {
+      std::unique_ptr<int> value = queue.Pop();
+      assert(value && *value == expected[i]);
+    }
+    std::unique_ptr<int> out[10];
+    assert(queue.PopN(out, 10) == 10);
+    for (int i = 0; i < 10; ++i) {
+      assert(*out[i] == expected[20 + i]);
+    }
+  }
+  {
+    Queue<std::string> queue;
+    assert(queue.Pop().empty());
+    std::string words[] = {"a", "bb", "ccc", "dddd", "eeeee", "ffffff", "ggggggg"};
+    queue.PushN(words, 7);
+    std::string out[7];
+    assert(queue.PopN(out, 10) == 7);
+    for (int i = 0; i < 7; ++i) {
+      assert(out[i] == words[i]);
+    }
+  }
+  {
+    Queue<int> queue;
+    Queue<int> fixed(ShrinkPolicy::never());
+    for (int i = 0; i < 10000; ++i) {
+      queue.Push(i);
+      fixed.Push(i);
+    }
+    assert(queue.UsedBytes() == 10000 * sizeof(int) && queue.ReservedBytes() >= queue.UsedBytes());
+    assert(fixed.ReservedBytes() == queue.ReservedBytes());
+
+    for (int i = 0; i < 9990; ++i) {
+      assert(queue.Pop() == i);
+      assert(fixed.Pop() == i);
+    }
+    assert(queue.ReservedBytes() < fixed.ReservedBytes() / 100);
+
+    fixed.ShrinkToFit();
+    assert(fixed.ReservedBytes() == fixed.UsedBytes());
+    for (int i = 9990; i < 10000; ++i) {
+      assert(queue.Pop() == i);
+      assert(fixed.Pop() == i);
+    }
+  }
+  {
+    SpscQueue<int> queue(5);
+    assert(queue.Pop() == -1);
+    for (int i = 0; i < 8; ++i) {
+      assert(queue.TryPush(i));
+    }
+    assert(!queue.TryPush(8));
+    for (int i = 0; i < 8; ++i) {
+      assert(queue.Pop() == i);
+    }
+    assert(queue.Pop() == -1);
+  }
+  {
+    const int count = 1000000;
+    SpscQueue<int> queue(64);
+    std::thread producer([&queue] {
+      for (int i = 0; i < count; ++i) {
+        queue.Push(i);
+      }
+    });
+
+    for (int expected = 0; expected < count;) {
+      int value;
+      if (queue.TryPop(value)) {
+        assert(value == expected);
+        ++expected;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+    producer.join();
+  }
+  {
+    MpmcQueue<int> queue(4);
+    int value = -1;
+    bool popped = queue.TryPop(value) || queue.TryPopFor(value, std::chrono::milliseconds(1));
+    assert(!popped && value == -1);
+    (void) popped;
+    for (int i = 0; i < 4; ++i) {
+      assert(queue.TryPush(i));
+    }
+    assert(!queue.TryPushFor(4, std::chrono::milliseconds(1)));
+    for (int i = 0; i < 4; ++i) {
+      assert(queue.Pop() == i);
+    }
+  }
+  {
+    const int producers = 3;
+    const int consumers = 3;
+    const int perProducer = 100000;
+    MpmcQueue<int> queue(16);
+    std::vector<std::atomic<int>> seen(producers * perProducer);
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+      threads.emplace_back([&queue, p] {
+        for (int i = 0; i < perProducer; ++i) {
+          queue.Push(p * perProducer + i);
+        }
+      });
+    }
+    for (int c = 0; c < consumers; ++c) {
+      threads.emplace_back([&queue, &seen] {
+        for (int i = 0; i < perProducer; ++i) {
+          seen[queue.Pop()]++;
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+
+    assert(std::all_of(seen.begin(), seen.end(), [](const std::atomic<int> &count) { return count == 1; }));
+  }
+}
+
+template<typename QueueType>
+void benchmarkQueue(const char *name) {
+  const long long count = 10000000;
+  {
+    QueueType queue;
+    auto start = std::chrono::steady_clock::now();
+    std::thread producer([&queue] {
+      for (long long i = 0; i < count; ++i) {
+        queue.Push(i);
+      }
+    });
+
+    long long sum = 0;
+    for (long long received = 0; received < count;) {
+      long long value = queue.Pop();
+      if (value != -1) {
+        sum += value;
+        ++received;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+    producer.join();
+    auto finish = std::chrono::steady_clock::now();
+
+    assert(sum == count * (count - 1) / 2);
+    std::cout << name << " throughput: "
+              << count * 1000 / std::chrono::duration_cast<std::chrono::microseconds>(finish - start).count()
+              << " Kops/s" << std::endl;
+  }
+  {
+    const long long pings = 100000;
+    QueueType queue;
+    std::thread producer([&queue] {
+      for (long long i = 0; i < pings; ++i) {
+        auto sent = std::chrono::steady_clock::now().time_since_epoch();
+        queue.Push(std::chrono::duration_cast<std::chrono::nanoseconds>(sent).count());
+        std::this_thread::yield();
+      }
+    });
+
+    long long total = 0;
+    for (long long received = 0; received < pings;) {
+      long long sent = queue.Pop();
+      if (sent != -1) {
+        auto now = std::chrono::steady_clock::now().time_since_epoch();
+        total += std::chrono::duration_cast<std::chrono::nanoseconds>(now).count() - sent;
+        ++received;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+    producer.join();
+
+    std::cout << name << " latency: " << total / pings << " ns" << std::endl;
+  }
+}
+
+template<typename QueueType>
+void benchmarkMany(const char *name, int producers, int consumers) {
+  const long long perProducer = 2000000;
+  QueueType queue;
+  std::atomic<long long> remaining(perProducer * producers);
+  std::atomic<long long> sum(0);
+  std::vector<std::thread> threads;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int p = 0; p < producers; ++p) {
+    threads.emplace_back([&queue] {
+      for (long long i = 0; i < perProducer; ++i) {
+        queue.Push(i);
+      }
+    });
+  }
+  for (int c = 0; c < consumers; ++c) {
+    threads.emplace_back([&queue, &remaining, &sum] {
+      long long local = 0;
+      long long value;
+      while (remaining.load(std::memory_order_relaxed) > 0) {
+        if (queue.TryPop(value)) {
+          local += value;
+          remaining.fetch_sub(1, std::memory_order_relaxed);
+        } else {
+          std::this_thread::yield();
+        }
+      }
+      sum += local;
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  auto finish = std::chrono::steady_clock::now();
+
+  assert(sum == producers * (perProducer * (perProducer - 1) / 2));
+  std::cout << name << " " << producers << "P/" << consumers << "C throughput: "
+            << perProducer * producers * 1000 / std::chrono::duration_cast<std::chrono::microseconds>(finish - start).count()
+            << " Kops/s" << std::endl;
+}
+
+template<typename QueueType>
+void benchmarkPushLatency(const char *name) {
+  const int count = 10000000;
+  QueueType queue;
+  std::vector<long long> latency(count);
+  for (int i = 0; i < count; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    queue.Push(i);
+    auto finish = std::chrono::steady_clock::now();
+    latency[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(finish - start).count();
+  }
+
+  std::sort(latency.begin(), latency.end());
+  std::cout << name << " push p50: " << latency[count / 2] << " ns, p99: " << latency[count / 100 * 99]
+            << " ns, p99.9: " << latency[count / 1000 * 999]
+            << " ns, max: " << latency.back() << " ns" << std::endl;
+}
+
+void benchmark() {
+  benchmarkPushLatency<Queue<long long>>("Queue");
+  benchmarkPushLatency<ChunkedQueue<long long>>("ChunkedQueue");
+  benchmarkQueue<LockedQueue<long long>>("Queue + mutex");
+  benchmarkQueue<SpscQueue<long long>>("SpscQueue");
+  for (int threads : {1, 2, 4, 8}) {
+    benchmarkMany<LockedQueue<long long>>("Queue + mutex", threads, threads);
+    benchmarkMany<MpmcQueue<long long>>("MpmcQueue", threads, threads);
+  }
 }
 
 int main() {
 //  test();
+//  benchmark();
   run(std::cin, std::cout);
 
   return 0;
@@ -10,32 +10,56 @@
 
 #define FIRST_ALLOC_SIZE 5
 #define REALLOC_SIZE 2
+#define BUCKETS_MAX_WEIGHT (1 << 24)
+#define MASK_WORD_BITS 64
+#define PAIRING_FIRST_BLOCK 64
+#define INDEXED_HEAP_SLOT_BITS 32
+#define INDEXED_HEAP_SLOT_MASK ((1LL << INDEXED_HEAP_SLOT_BITS) - 1)
 
 #include <iostream>
 #include <algorithm>
 #include <sstream>
 #include <cassert>
-#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include <queue>
+#include <chrono>
+#include <cstdlib>
+#include <iterator>
+#include <type_traits>
+#include <climits>
+#include <map>
 
-template<class T, typename Comparator = std::greater<T>>
+#include "../common/FastInput.h"
+#include "../common/RawStorage.h"
+#include "../common/ShrinkPolicy.h"
+
+// Arity - число детей у узла. При 4 и 8 дерево ниже, а дети узла лежат в одной-двух кэш-линиях
+template<class T, typename Comparator = std::greater<T>, int Arity = 2>
 class Heap {
+  static_assert(Arity >= 2, "Heap arity must be at least 2");
+
  public:
-  Heap()
+  explicit Heap(ShrinkPolicy shrink = ShrinkPolicy())
       : bufferSize(0),
         allocSize(FIRST_ALLOC_SIZE),
-        buffer(new T[allocSize]) {
+        buffer(allocateStorage<T>(allocSize)),
+        shrink(shrink) {
   }
 
-  explicit Heap(const T array[], int size)
+  explicit Heap(const T array[], int size, ShrinkPolicy shrink = ShrinkPolicy())
       : bufferSize(size),
-        allocSize(size * REALLOC_SIZE),
-        buffer(new T[allocSize]) {
-    std::memcpy(buffer, array, bufferSize * sizeof(T));
+        allocSize(std::max(size * REALLOC_SIZE, FIRST_ALLOC_SIZE)),
+        buffer(allocateStorage<T>(allocSize)),
+        shrink(shrink) {
+    copyConstruct(buffer, array, bufferSize);
     build();
   }
 
   ~Heap() {
-    delete[] buffer;
+    destroyElements(buffer, bufferSize);
+    freeStorage(buffer);
   }
 
   bool isEmpty() {
@@ -43,18 +67,24 @@ class Heap {
   }
 
   void insert(T val) {
+    emplace(std::move(val));
+  }
+
+  // Конструирует элемент прямо в буфере
+  template<typename... Args>
+  void emplace(Args &&... args) {
     if (allocSize == bufferSize) {
-      resize();
+      reallocate(allocSize * REALLOC_SIZE);
     }
 
-    buffer[bufferSize] = val;
+    new(buffer + bufferSize) T(std::forward<Args>(args)...);
     siftUp(bufferSize);
     bufferSize++;
   }
 
   T getTop() {
     if (bufferSize == 0) {
-      return -1;
+      return emptyValue<T>();
     }
 
     return buffer[0];
@@ -62,17 +92,96 @@ class Heap {
 
   T extractTop() {
     if (bufferSize == 0) {
-      return -1;
+      return emptyValue<T>();
     }
 
-    T result = buffer[0];
-    buffer[0] = buffer[bufferSize - 1];
-    siftDown(0);
-    bufferSize--;
+    return popTop();
+  }
+
+  // Достаёт вершины в out, пока pred(вершина) истинно; возвращает сколько достал.
+  // pred может хранить состояние, например набранный вес
+  template<typename Predicate, typename OutputIt>
+  int extractWhile(Predicate pred, OutputIt out) {
+    int count = 0;
+    while (bufferSize != 0 && pred(static_cast<const T &>(buffer[0]))) {
+      *out++ = popTop();
+      ++count;
+    }
+    return count;
+  }
+
+  // Большая пачка (не меньше текущего размера кучи) дописывается в конец, и куча
+  // перестраивается за O(n + count); маленькая вставляется поэлементно через siftUp
+  template<typename ForwardIt>
+  void insertBatch(ForwardIt first, ForwardIt last) {
+    int count = static_cast<int>(std::distance(first, last));
+    if (count <= 0) {
+      return;
+    }
+
+    if (allocSize - bufferSize < count) {
+      int newSize = allocSize;
+      do {
+        newSize *= REALLOC_SIZE;
+      } while (newSize < bufferSize + count);
+      reallocate(newSize);
+    }
+
+    if (count < bufferSize) {
+      for (; first != last; ++first) {
+        new(buffer + bufferSize) T(*first);
+        siftUp(bufferSize);
+        bufferSize++;
+      }
+      return;
+    }
+
+    for (; first != last; ++first) {
+      new(buffer + bufferSize) T(*first);
+      bufferSize++;
+    }
+    build();
+  }
+
+  // Заменяет вершину на value одним спуском вместо extractTop + insert, возвращает старую вершину
+  T replaceTop(T value) {
+    if (bufferSize == 0) {
+      insert(std::move(value));
+      return emptyValue<T>();
+    }
 
+    T result = std::move(buffer[0]);
+    buffer[0] = std::move(value);
+    siftDown(0);
     return result;
   }
 
+  // То же, что insert(value) и затем extractTop(), но если value не ниже вершины,
+  // куча не трогается вовсе
+  T pushPop(T value) {
+    if (bufferSize == 0 || !cmp(buffer[0], value)) {
+      return value;
+    }
+
+    return replaceTop(std::move(value));
+  }
+
+  // Отдаёт лишнюю память: ёмкость становится равна размеру (но не меньше FIRST_ALLOC_SIZE)
+  void shrinkToFit() {
+    int fit = std::max(bufferSize, FIRST_ALLOC_SIZE);
+    if (fit != allocSize) {
+      reallocate(fit);
+    }
+  }
+
+  size_t reservedBytes() const {
+    return static_cast<size_t>(allocSize) * sizeof(T);
+  }
+
+  size_t usedBytes() const {
+    return static_cast<size_t>(bufferSize) * sizeof(T);
+  }
+
   Heap(const Heap &other) = delete;
   Heap(Heap &&other) = delete;
   Heap &operator=(const Heap &other) = delete;
@@ -83,62 +192,330 @@ class Heap {
   int allocSize;
   T *buffer;
   Comparator cmp;
+  ShrinkPolicy shrink;
+
+  T popTop() {
+    T result = std::move(buffer[0]);
+    --bufferSize;
+    if (bufferSize != 0) {
+      int hole = siftHoleToBottom(0);
+      buffer[hole] = std::move(buffer[bufferSize]);
+      siftUp(hole);
+    }
+    buffer[bufferSize].~T();
+
+    int newSize = shrink.onRemove(bufferSize, allocSize, FIRST_ALLOC_SIZE);
+    if (newSize != allocSize) {
+      reallocate(newSize);
+    }
+    return result;
+  }
 
   void build() {
-    for (int i = bufferSize / 2 - 1; i >= 0; --i) {
+    if (bufferSize < 2) {
+      return;
+    }
+
+    for (int i = (bufferSize - 2) / Arity; i >= 0; --i) {
       siftDown(i);
     }
   }
 
-  void resize() {
-    allocSize *= REALLOC_SIZE;
-    auto *newBuffer = new T[allocSize];
+  // Элементы переносятся в новый буфер перемещением, а не копированием
+  void reallocate(int newSize) {
+    T *newBuffer = allocateStorage<T>(newSize);
 
-    std::memcpy(newBuffer, buffer, bufferSize * sizeof(T));
-    delete[] buffer;
+    relocateElements(newBuffer, buffer, bufferSize);
+    freeStorage(buffer);
     buffer = newBuffer;
+    allocSize = newSize;
+    shrink.onResize();
   }
 
-  void siftDown(int index) {
-    int leftChild = 2 * index + 1;
-    int rightChild = 2 * index + 2;
+  // Лучший из детей с first по first + Arity - 1. Выбор через тернарный оператор
+  // компилируется в cmov, а полная группа детей - в развёрнутый цикл без ветвлений
+  int bestChild(int first) const {
+    int best = first;
+    if (first + Arity <= bufferSize) {
+      for (int i = 1; i < Arity; ++i) {
+        best = cmp(buffer[first + i], buffer[best]) ? first + i : best;
+      }
+    } else {
+      for (int i = first + 1; i < bufferSize; ++i) {
+        best = cmp(buffer[i], buffer[best]) ? i : best;
+      }
+    }
+    return best;
+  }
 
-    if (leftChild < bufferSize && cmp(buffer[leftChild], buffer[index])) {
-      std::swap(buffer[leftChild], buffer[index]);
-      siftDown(leftChild);
+  // Элемент не меняется местами с детьми на каждом уровне, а переносится один раз в конце
+  void siftDown(int index) {
+    T value = std::move(buffer[index]);
+    for (int first = index * Arity + 1; first < bufferSize; first = index * Arity + 1) {
+      int best = bestChild(first);
+      if (!cmp(buffer[best], value)) {
+        break;
+      }
+      buffer[index] = std::move(buffer[best]);
+      index = best;
     }
+    buffer[index] = std::move(value);
+  }
 
-    if (rightChild < bufferSize && cmp(buffer[rightChild], buffer[index])) {
-      std::swap(buffer[rightChild], buffer[index]);
-      siftDown(rightChild);
+  // Спуск Флойда: дырка опускается до листа по лучшим детям без сравнения с вставляемым
+  // элементом (он почти всегда возвращается на нижние уровни), затем элемент поднимается siftUp
+  int siftHoleToBottom(int index) {
+    for (int first = index * Arity + 1; first < bufferSize; first = index * Arity + 1) {
+      int best = bestChild(first);
+      buffer[index] = std::move(buffer[best]);
+      index = best;
     }
+    return index;
   }
 
   void siftUp(int index) {
-    int parent = (index - 1) / 2;
-
-    if (parent >= 0 && cmp(buffer[index], buffer[parent])) {
-      std::swap(buffer[parent], buffer[index]);
-      siftUp(parent);
+    T value = std::move(buffer[index]);
+    while (index > 0) {
+      int parent = (index - 1) / Arity;
+      if (!cmp(value, buffer[parent])) {
+        break;
+      }
+      buffer[index] = std::move(buffer[parent]);
+      index = parent;
     }
+    buffer[index] = std::move(value);
   }
 };
 
-void run(std::istream &is, std::ostream &os) {
-  int n = 0;
-  is >> n;
+// Куча с адресуемыми элементами: insert возвращает дескриптор, по которому можно изменить
+// приоритет или удалить элемент за O(log n). Элемент занимает слот: positions[slot] - индекс
+// элемента в куче (-1, если слот свободен), slots[i] - слот элемента на позиции i; оба обновляются
+// при каждом сдвиге. Слоты удалённых элементов переиспользуются, а дескриптор - это слот плюс его
+// поколение в старших битах, поэтому старый дескриптор не указывает на новый элемент того же слота.
+template<class T, typename Comparator = std::greater<T>, int Arity = 2>
+class IndexedHeap {
+  static_assert(Arity >= 2, "Heap arity must be at least 2");
+
+ public:
+  typedef long long Handle;
+
+  IndexedHeap() {
+  }
+
+  bool isEmpty() const {
+    return values.empty();
+  }
+
+  int size() const {
+    return static_cast<int>(values.size());
+  }
+
+  Handle insert(T value) {
+    int slot;
+    if (freeSlots.empty()) {
+      slot = static_cast<int>(positions.size());
+      positions.push_back(-1);
+      generations.push_back(0);
+    } else {
+      slot = freeSlots.back();
+      freeSlots.pop_back();
+    }
+
+    values.push_back(std::move(value));
+    slots.push_back(slot);
+    positions[slot] = size() - 1;
+    siftUp(size() - 1);
+    return makeHandle(slot);
+  }
+
+  bool contains(Handle handle) const {
+    int slot = static_cast<int>(handle & INDEXED_HEAP_SLOT_MASK);
+    return handle >= 0 && slot < static_cast<int>(positions.size()) && positions[slot] != -1
+        && (handle >> INDEXED_HEAP_SLOT_BITS) == generations[slot];
+  }
+
+  const T &get(Handle handle) const {
+    assert(contains(handle));
+    return values[positions[handle & INDEXED_HEAP_SLOT_MASK]];
+  }
+
+  T getTop() {
+    if (isEmpty()) {
+      return emptyValue<T>();
+    }
+
+    return values[0];
+  }
+
+  Handle topHandle() const {
+    return isEmpty() ? -1 : makeHandle(slots[0]);
+  }
+
+  T extractTop() {
+    if (isEmpty()) {
+      return emptyValue<T>();
+    }
+
+    return take(0);
+  }
+
+  // Направление сдвига определяет компаратор, поэтому оба метода подходят
+  // и для кучи на максимум, и для кучи на минимум. Для устаревшего дескриптора возвращают false
+  bool decreaseKey(Handle handle, T value) {
+    return changeKey(handle, std::move(value));
+  }
+
+  bool increaseKey(Handle handle, T value) {
+    return changeKey(handle, std::move(value));
+  }
+
+  bool erase(Handle handle) {
+    if (!contains(handle)) {
+      return false;
+    }
+
+    take(positions[handle & INDEXED_HEAP_SLOT_MASK]);
+    return true;
+  }
+
+  IndexedHeap(const IndexedHeap &other) = delete;
+  IndexedHeap(IndexedHeap &&other) = delete;
+  IndexedHeap &operator=(const IndexedHeap &other) = delete;
+  IndexedHeap &operator=(IndexedHeap &&other) = delete;
+
+ private:
+  std::vector<T> values;
+  std::vector<int> slots;
+  std::vector<int> positions;
+  std::vector<int> generations;
+  std::vector<int> freeSlots;
+  Comparator cmp;
 
+  Handle makeHandle(int slot) const {
+    return static_cast<Handle>(generations[slot]) << INDEXED_HEAP_SLOT_BITS | slot;
+  }
+
+  bool changeKey(Handle handle, T value) {
+    if (!contains(handle)) {
+      return false;
+    }
+
+    int index = positions[handle & INDEXED_HEAP_SLOT_MASK];
+    values[index] = std::move(value);
+    restore(index);
+    return true;
+  }
+
+  // Удаляет элемент с позиции index: на его место встаёт последний и сдвигается куда нужно
+  T take(int index) {
+    int slot = slots[index];
+    T result = std::move(values[index]);
+
+    int last = size() - 1;
+    if (index != last) {
+      place(index, std::move(values[last]), slots[last]);
+    }
+    values.pop_back();
+    slots.pop_back();
+    if (index != last) {
+      restore(index);
+    }
+
+    positions[slot] = -1;
+    generations[slot] = (generations[slot] + 1) & INT_MAX;
+    freeSlots.push_back(slot);
+    return result;
+  }
+
+  void place(int index, T &&value, int slot) {
+    values[index] = std::move(value);
+    slots[index] = slot;
+    positions[slot] = index;
+  }
+
+  void restore(int index) {
+    if (index > 0 && cmp(values[index], values[(index - 1) / Arity])) {
+      siftUp(index);
+    } else {
+      siftDown(index);
+    }
+  }
+
+  void siftDown(int index) {
+    T value = std::move(values[index]);
+    int slot = slots[index];
+    for (int first = index * Arity + 1; first < size(); first = index * Arity + 1) {
+      int best = first;
+      int last = std::min(first + Arity, size());
+      for (int i = first + 1; i < last; ++i) {
+        best = cmp(values[i], values[best]) ? i : best;
+      }
+      if (!cmp(values[best], value)) {
+        break;
+      }
+      place(index, std::move(values[best]), slots[best]);
+      index = best;
+    }
+    place(index, std::move(value), slot);
+  }
+
+  void siftUp(int index) {
+    T value = std::move(values[index]);
+    int slot = slots[index];
+    while (index > 0) {
+      int parent = (index - 1) / Arity;
+      if (!cmp(value, values[parent])) {
+        break;
+      }
+      place(index, std::move(values[parent]), slots[parent]);
+      index = parent;
+    }
+    place(index, std::move(value), slot);
+  }
+};
+
+// Число подходов. За подход из кучи одной пачкой достаются самые тяжёлые фрукты,
+// пока они помещаются в k, и огрызки одной пачкой возвращаются обратно
+int countSteps(const std::vector<int> &weights, int k) {
   Heap<int> heap;
-  for (int i = 0; i < n; ++i) {
-    int a;
-    is >> a;
-    heap.insert(a);
+  heap.insertBatch(weights.begin(), weights.end());
+
+  std::vector<int> taken;
+  int steps = 0;
+  while (!heap.isEmpty()) {
+    int weight = 0;
+    taken.clear();
+    heap.extractWhile([&weight, k](int top) {
+      if (weight + top > k) {
+        return false;
+      }
+      weight += top;
+      return true;
+    }, std::back_inserter(taken));
+
+    size_t left = 0;
+    for (int fruit : taken) {
+      if (fruit != 1) {
+        taken[left++] = fruit / 2;
+      }
+    }
+    taken.resize(left);
+    heap.insertBatch(taken.begin(), taken.end());
+
+    steps++;
   }
 
-  int k;
-  is >> k;
-  auto buffer = new int[k];
+  return steps;
+}
+
+// Прежний вариант: getTop на каждом шаге и вставка огрызков по одному. Оставлен для benchmark()
+int countStepsOneByOne(const std::vector<int> &weights, int k) {
+  Heap<int> heap;
+  for (int weight : weights) {
+    heap.insert(weight);
+  }
 
+  std::vector<int> buffer(k);
   int steps = 0;
   while (!heap.isEmpty()) {
     int i = 0;
@@ -158,9 +535,521 @@ void run(std::istream &is, std::ostream &os) {
     steps++;
   }
 
-  os << steps;
+  return steps;
 }
 
+// Парная куча: слияние и вставка за O(1), extractTop и изменение ключа за амортизированные O(log n).
+// Узлы берутся из собственного пула: блоки растущего размера плюс список свободных узлов.
+// При meld блоки и свободные узлы другой кучи переходят к этой, поэтому дескрипторы остаются верными
+template<class T, typename Comparator = std::greater<T>>
+class PairingHeap {
+  struct Node;
+
+ public:
+  typedef Node *Handle;
+
+  PairingHeap()
+      : root(nullptr), count(0), firstBlock(nullptr), lastBlock(nullptr), blockUsed(0), blockSize(0),
+        freeHead(nullptr), freeTail(nullptr) {
+  }
+
+  ~PairingHeap() {
+    std::vector<Node *> stack;
+    if (root) {
+      stack.push_back(root);
+    }
+    while (!stack.empty()) {
+      Node *node = stack.back();
+      stack.pop_back();
+      for (Node *child = node->child; child; child = child->sibling) {
+        stack.push_back(child);
+      }
+      node->value().~T();
+    }
+
+    while (firstBlock) {
+      Block *next = firstBlock->next;
+      freeStorage(firstBlock->nodes);
+      delete firstBlock;
+      firstBlock = next;
+    }
+  }
+
+  bool isEmpty() const {
+    return root == nullptr;
+  }
+
+  int size() const {
+    return count;
+  }
+
+  Handle insert(T value) {
+    Node *node = allocateNode();
+    new(&node->storage) T(std::move(value));
+    root = link(root, node);
+    ++count;
+    return node;
+  }
+
+  const T &get(Handle handle) const {
+    return handle->value();
+  }
+
+  T getTop() {
+    if (isEmpty()) {
+      return emptyValue<T>();
+    }
+
+    return root->value();
+  }
+
+  Handle topHandle() const {
+    return root;
+  }
+
+  T extractTop() {
+    if (isEmpty()) {
+      return emptyValue<T>();
+    }
+
+    Node *top = root;
+    T result = std::move(top->value());
+    root = mergePairs(top->child);
+    releaseNode(top);
+    --count;
+    return result;
+  }
+
+  // Забирает все элементы other за O(1), other становится пустой
+  void meld(PairingHeap &other) {
+    if (this == &other) {
+      return;
+    }
+
+    root = link(root, other.root);
+    count += other.count;
+
+    // Блоки other встают в начало списка: последний блок, из которого раздаются узлы, остаётся своим
+    if (!firstBlock) {
+      firstBlock = other.firstBlock;
+      lastBlock = other.lastBlock;
+      blockUsed = other.blockUsed;
+      blockSize = other.blockSize;
+    } else if (other.firstBlock) {
+      other.lastBlock->next = firstBlock;
+      firstBlock = other.firstBlock;
+    }
+    if (other.freeHead) {
+      if (freeTail) {
+        freeTail->sibling = other.freeHead;
+      } else {
+        freeHead = other.freeHead;
+      }
+      freeTail = other.freeTail;
+    }
+
+    other.root = nullptr;
+    other.count = 0;
+    other.firstBlock = other.lastBlock = nullptr;
+    other.blockUsed = other.blockSize = 0;
+    other.freeHead = other.freeTail = nullptr;
+  }
+
+  // Как и у IndexedHeap, направление определяет компаратор: узел, поднявшийся выше,
+  // отрезается и сливается с корнем, опустившийся - ещё и отдаёт своих детей
+  void decreaseKey(Handle handle, T value) {
+    changeKey(handle, std::move(value));
+  }
+
+  void increaseKey(Handle handle, T value) {
+    changeKey(handle, std::move(value));
+  }
+
+  PairingHeap(const PairingHeap &other) = delete;
+  PairingHeap(PairingHeap &&other) = delete;
+  PairingHeap &operator=(const PairingHeap &other) = delete;
+  PairingHeap &operator=(PairingHeap &&other) = delete;
+
+ private:
+  // prev - левый брат или родитель, если узел первый в списке детей.
+  // Значение живёт в storage и конструируется только у занятых узлов
+  struct Node {
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    Node *child;
+    Node *sibling;
+    Node *prev;
+
+    T &value() {
+      return *reinterpret_cast<T *>(&storage);
+    }
+
+    const T &value() const {
+      return *reinterpret_cast<const T *>(&storage);
+    }
+  };
+
+  struct Block {
+    Node *nodes;
+    Block *next;
+  };
+
+  Node *root;
+  int count;
+  Block *firstBlock;
+  Block *lastBlock;
+  int blockUsed;
+  int blockSize;
+  Node *freeHead;
+  Node *freeTail;
+  Comparator cmp;
+
+  Node *allocateNode() {
+    Node *node;
+    if (freeHead) {
+      node = freeHead;
+      freeHead = node->sibling;
+      if (!freeHead) {
+        freeTail = nullptr;
+      }
+    } else {
+      if (blockUsed == blockSize) {
+        blockSize = blockSize == 0 ? PAIRING_FIRST_BLOCK : blockSize * REALLOC_SIZE;
+        blockUsed = 0;
+        Block *block = new Block{allocateStorage<Node>(blockSize), nullptr};
+        if (lastBlock) {
+          lastBlock->next = block;
+        } else {
+          firstBlock = block;
+        }
+        lastBlock = block;
+      }
+      node = lastBlock->nodes + blockUsed++;
+    }
+
+    node->child = node->sibling = node->prev = nullptr;
+    return node;
+  }
+
+  void releaseNode(Node *node) {
+    node->value().~T();
+    node->sibling = nullptr;
+    if (freeTail) {
+      freeTail->sibling = node;
+    } else {
+      freeHead = node;
+    }
+    freeTail = node;
+  }
+
+  // Сливает два дерева, у корней которых нет братьев; возвращает новый корень
+  Node *link(Node *first, Node *second) {
+    if (!first) {
+      return second;
+    }
+    if (!second) {
+      return first;
+    }
+    if (cmp(second->value(), first->value())) {
+      std::swap(first, second);
+    }
+
+    second->sibling = first->child;
+    if (first->child) {
+      first->child->prev = second;
+    }
+    second->prev = first;
+    first->child = second;
+    first->prev = nullptr;
+    return first;
+  }
+
+  // Двухпроходное слияние списка братьев: пары слева направо, затем справа налево
+  Node *mergePairs(Node *first) {
+    Node *pairs = nullptr;
+    while (first) {
+      Node *left = first;
+      Node *right = left->sibling;
+      first = right ? right->sibling : nullptr;
+
+      left->sibling = left->prev = nullptr;
+      if (right) {
+        right->sibling = right->prev = nullptr;
+      }
+      Node *pair = link(left, right);
+      pair->sibling = pairs;
+      pairs = pair;
+    }
+
+    Node *result = nullptr;
+    while (pairs) {
+      Node *next = pairs->sibling;
+      pairs->sibling = nullptr;
+      result = link(result, pairs);
+      pairs = next;
+    }
+    return result;
+  }
+
+  void cut(Node *node) {
+    if (node->prev->child == node) {
+      node->prev->child = node->sibling;
+    } else {
+      node->prev->sibling = node->sibling;
+    }
+    if (node->sibling) {
+      node->sibling->prev = node->prev;
+    }
+    node->sibling = node->prev = nullptr;
+  }
+
+  void changeKey(Node *node, T value) {
+    bool raised = !cmp(node->value(), value);
+    node->value() = std::move(value);
+
+    if (node != root) {
+      cut(node);
+    } else {
+      root = nullptr;
+    }
+    if (!raised) {
+      Node *children = mergePairs(node->child);
+      node->child = nullptr;
+      node = link(node, children);
+    }
+    root = link(root, node);
+  }
+};
+
+// Старший непустой вес, не больше from, по битовой маске непустых корзин; 0, если такого нет
+int previousNonEmpty(const std::vector<unsigned long long> &mask, int from) {
+  int word = from / MASK_WORD_BITS;
+  unsigned long long bits = mask[word] & (~0ULL >> (MASK_WORD_BITS - 1 - from % MASK_WORD_BITS));
+  while (bits == 0) {
+    if (word == 0) {
+      return 0;
+    }
+    bits = mask[--word];
+  }
+  return word * MASK_WORD_BITS + MASK_WORD_BITS - 1 - __builtin_clzll(bits);
+}
+
+// Тот же жадный процесс без кучи: веса не больше k, поэтому достаточно счётчиков по весам.
+// Подход идёт от старшей непустой корзины вниз и берёт сразу всю группу одинаковых фруктов,
+// сколько помещается. Подряд идущие подходы, которые упираются в одну и ту же старшую корзину
+// (в ней больше фруктов, чем помещается за раз), выполняются одной арифметикой
+int countStepsBuckets(const std::vector<int> &weights, int k) {
+  std::vector<int> counts(k + 1, 0);
+  std::vector<unsigned long long> mask(k / MASK_WORD_BITS + 1, 0);
+  auto add = [&counts, &mask](int weight, int count) {
+    counts[weight] += count;
+    mask[weight / MASK_WORD_BITS] |= 1ULL << (weight % MASK_WORD_BITS);
+  };
+  auto drop = [&mask](int weight) {
+    mask[weight / MASK_WORD_BITS] &= ~(1ULL << (weight % MASK_WORD_BITS));
+  };
+
+  for (int weight : weights) {
+    add(weight, 1);
+  }
+
+  // Огрызки возвращаются в корзины только после подхода, чтобы не попасть в него же
+  std::vector<std::pair<int, int>> bitten;
+  int steps = 0;
+  for (int top = previousNonEmpty(mask, k); top != 0; top = previousNonEmpty(mask, top)) {
+    int fit = k / top;
+    if (counts[top] > fit) {
+      int rounds = (counts[top] - 1) / fit;
+      counts[top] -= rounds * fit;
+      if (top != 1) {
+        add(top / 2, rounds * fit);
+      }
+      steps += rounds;
+    }
+
+    int left = k;
+    for (int weight = top; weight != 0 && weight <= left; weight = previousNonEmpty(mask, weight - 1)) {
+      int taken = std::min(counts[weight], left / weight);
+      left -= taken * weight;
+      counts[weight] -= taken;
+      if (weight != 1) {
+        bitten.emplace_back(weight / 2, taken);
+      }
+      if (counts[weight] != 0) {
+        break;
+      }
+      drop(weight);
+    }
+
+    for (const auto &group : bitten) {
+      add(group.first, group.second);
+    }
+    bitten.clear();
+    steps++;
+  }
+
+  return steps;
+}
+
+template<typename Input>
+void run(Input &is, std::ostream &os) {
+  int n = 0;
+  is >> n;
+
+  std::vector<int> weights(n);
+  for (int i = 0; i < n; ++i) {
+    is >> weights[i];
+  }
+
+  int k;
+  is >> k;
+
+  bool bounded = k >= 1 && k <= BUCKETS_MAX_WEIGHT;
+  for (int weight : weights) {
+    bounded = bounded && weight >= 1 && weight <= k;
+  }
+  os << (bounded ? countStepsBuckets(weights, k) : countSteps(weights, k));
+}
+
+void run(const char *begin, const char *end, std::ostream &os) {
+  InputReader reader(begin, end);
+  run(reader, os);
+}
+
+template<int Arity>
+void testArity() {
+  std::vector<int> values;
+  for (int i = 0; i < 1000; ++i) {
+    values.push_back(std::rand() % 100);
+  }
+
+  Heap<int, std::greater<int>, Arity> built(values.data(), static_cast<int>(values.size()));
+  Heap<int, std::less<int>, Arity> inserted;
+  for (int value : values) {
+    inserted.insert(value);
+  }
+
+  std::vector<int> sorted = values;
+  std::sort(sorted.begin(), sorted.end());
+  for (size_t i = 0; i < sorted.size(); ++i) {
+    assert(built.extractTop() == sorted[sorted.size() - 1 - i]);
+    assert(inserted.extractTop() == sorted[i]);
+  }
+  assert(built.isEmpty() && inserted.isEmpty());
+}
+
+// Случайные insert/extractTop/decreaseKey/increaseKey/erase сверяются с полным перебором.
+// Запросы идут и по устаревшим дескрипторам, чьи слоты уже заняты новыми элементами
+template<int Arity>
+void testIndexedHeap() {
+  typedef typename IndexedHeap<int, std::less<int>, Arity>::Handle Handle;
+  IndexedHeap<int, std::less<int>, Arity> heap;
+  std::vector<Handle> issued;
+  std::map<Handle, int> keys;
+
+  for (int step = 0; step < 20000; ++step) {
+    int action = std::rand() % 6;
+    if (action < 2 || heap.isEmpty()) {
+      int key = std::rand() % 1000;
+      Handle handle = heap.insert(key);
+      assert(std::find(issued.begin(), issued.end(), handle) == issued.end());
+      issued.push_back(handle);
+      keys[handle] = key;
+    } else {
+      Handle handle = issued[std::rand() % issued.size()];
+      bool alive = keys.count(handle) != 0;
+      if (action == 2) {
+        Handle top = heap.topHandle();
+        assert(heap.extractTop() == keys[top]);
+        keys.erase(top);
+      } else if (action == 5) {
+        assert(heap.erase(handle) == alive);
+        keys.erase(handle);
+      } else {
+        int key = (alive ? keys[handle] : 0) + (action == 3 ? -(std::rand() % 100) : std::rand() % 100);
+        bool changed = action == 3 ? heap.decreaseKey(handle, key) : heap.increaseKey(handle, key);
+        assert(changed == alive);
+        (void) changed;
+        if (alive) {
+          keys[handle] = key;
+        }
+      }
+    }
+
+    int minimum = 0;
+    for (auto it = keys.begin(); it != keys.end(); ++it) {
+      minimum = it == keys.begin() ? it->second : std::min(minimum, it->second);
+      assert(heap.contains(it->first) && heap.get(it->first) == it->second);
+    }
+    assert(heap.size() == static_cast<int>(keys.size()));
+    assert(keys.empty() || heap.getTop() == minimum);
+  }
+  assert(std::all_of(issued.begin(), issued.end(), [&](Handle handle) {
+    return heap.contains(handle) == (keys.count(handle) != 0);
+  }));
+}
+
+// Случайные insert/extractTop/meld/decreaseKey/increaseKey сверяются с полным перебором
+void testPairingHeap() {
+  typedef PairingHeap<int, std::less<int>> MinHeap;
+  MinHeap heap;
+  std::vector<MinHeap::Handle> handles;
+  std::vector<int> keys;
+  std::vector<bool> alive;
+
+  for (int step = 0; step < 5000; ++step) {
+    int action = std::rand() % 6;
+    if (action < 2 || heap.isEmpty()) {
+      keys.push_back(std::rand() % 1000);
+      alive.push_back(true);
+      handles.push_back(heap.insert(keys.back()));
+    } else if (action == 2) {
+      MinHeap other;
+      for (int i = std::rand() % 20; i > 0; --i) {
+        keys.push_back(std::rand() % 1000);
+        alive.push_back(true);
+        handles.push_back(other.insert(keys.back()));
+      }
+      heap.meld(other);
+      assert(other.isEmpty() && other.size() == 0);
+    } else if (action == 3) {
+      size_t found = 0;
+      while (!alive[found] || handles[found] != heap.topHandle()) {
+        ++found;
+      }
+      assert(heap.extractTop() == keys[found]);
+      alive[found] = false;
+    } else {
+      size_t index = std::rand() % keys.size();
+      if (alive[index]) {
+        keys[index] += action == 4 ? -(std::rand() % 100) : std::rand() % 100;
+        if (action == 4) {
+          heap.decreaseKey(handles[index], keys[index]);
+        } else {
+          heap.increaseKey(handles[index], keys[index]);
+        }
+      }
+    }
+
+    int count = 0;
+    int minimum = 0;
+    for (size_t i = 0; i < keys.size(); ++i) {
+      if (alive[i]) {
+        minimum = count == 0 ? keys[i] : std::min(minimum, keys[i]);
+        ++count;
+        assert(heap.get(handles[i]) == keys[i]);
+      }
+    }
+    assert(heap.size() == count);
+    assert(count == 0 || heap.getTop() == minimum);
+  }
+}
+
+struct GreaterPointee {
+  bool operator()(const std::unique_ptr<int> &l, const std::unique_ptr<int> &r) const {
+    return *l > *r;
+  }
+};
+
 void test() {
   {
     std::stringstream input;
@@ -198,10 +1087,292 @@ void test() {
 
     assert(output.str() == "3");
   }
+  {
+    Heap<std::unique_ptr<int>, GreaterPointee> heap;
+    for (int i = 0; i < 20; ++i) {
+      heap.emplace(new int((i * 7) % 20));
+    }
+
+    for (int i = 19; i >= 0; --i) {
+      assert(*heap.extractTop() == i);
+    }
+    assert(heap.extractTop() == nullptr);
+  }
+  {
+    std::string words[] = {"pear", "apple", "plum", "fig"};
+    Heap<std::string> heap(words, 4);
+    heap.insert("quince");
+
+    assert(heap.extractTop() == "quince");
+    assert(heap.extractTop() == "plum");
+    assert(heap.getTop() == "pear");
+    assert(words[0] == "pear");
+  }
+  {
+    Heap<int> heap;
+    Heap<int> fixed(ShrinkPolicy::never());
+    for (int i = 0; i < 10000; ++i) {
+      heap.insert(i);
+      fixed.insert(i);
+    }
+    assert(fixed.reservedBytes() == heap.reservedBytes());
+
+    for (int i = 9999; i >= 100; --i) {
+      assert(heap.extractTop() == i);
+      assert(fixed.extractTop() == i);
+    }
+    assert(heap.reservedBytes() < fixed.reservedBytes() / 10 && heap.reservedBytes() >= heap.usedBytes());
+
+    fixed.shrinkToFit();
+    assert(fixed.reservedBytes() == fixed.usedBytes());
+    assert(fixed.extractTop() == 99 && heap.extractTop() == 99);
+  }
+  testArity<2>();
+  testArity<4>();
+  testArity<8>();
+  {
+    Heap<int> heap;
+    assert(heap.replaceTop(5) == -1 && heap.getTop() == 5);
+    assert(heap.pushPop(7) == 7 && heap.getTop() == 5);
+
+    int small[] = {3, 1, 4};
+    heap.insertBatch(small, small + 3);
+    std::vector<int> large(100);
+    for (int i = 0; i < 100; ++i) {
+      large[i] = i * 37 % 100 + 10;
+    }
+    heap.insertBatch(large.begin(), large.end());
+
+    assert(heap.replaceTop(0) == 109);
+    assert(heap.pushPop(2) == 108);
+    std::vector<int> out;
+    assert(heap.extractWhile([](int top) { return top >= 10; }, std::back_inserter(out)) == 98);
+    for (int i = 0; i < 98; ++i) {
+      assert(out[i] == 107 - i);
+    }
+    assert(heap.extractTop() == 5 && heap.extractTop() == 4 && heap.extractTop() == 3);
+  }
+  for (int k : {1, 2, 7, 50, 63, 64, 65, 1000}) {
+    std::vector<int> weights;
+    for (int i = 0; i < 300; ++i) {
+      weights.push_back(1 + std::rand() % k);
+    }
+    assert(countSteps(weights, k) == countStepsOneByOne(weights, k));
+    assert(countStepsBuckets(weights, k) == countStepsOneByOne(weights, k));
+  }
+  testIndexedHeap<2>();
+  testIndexedHeap<4>();
+  testPairingHeap();
+  {
+    PairingHeap<std::string> first;
+    PairingHeap<std::string> second;
+    first.insert("fig");
+    auto plum = first.insert("plum");
+    second.insert("apple");
+    second.insert("quince");
+    first.meld(second);
+    second.insert("cherry");
+
+    first.decreaseKey(plum, "banana");
+    assert(first.extractTop() == "quince");
+    assert(first.extractTop() == "fig");
+    assert(second.getTop() == "cherry");
+    assert(PairingHeap<std::string>().extractTop().empty());
+  }
+  {
+    IndexedHeap<std::string> heap;
+    IndexedHeap<std::string>::Handle pear = heap.insert("pear");
+    heap.insert("apple");
+    IndexedHeap<std::string>::Handle fig = heap.insert("fig");
+    assert(heap.getTop() == "pear");
+
+    heap.decreaseKey(pear, "banana");
+    heap.increaseKey(fig, "zucchini");
+    assert(heap.extractTop() == "zucchini");
+    assert(!heap.contains(fig) && !heap.erase(fig));
+
+    // Слот fig достаётся kiwi, но старый дескриптор его не видит
+    IndexedHeap<std::string>::Handle kiwi = heap.insert("kiwi");
+    assert(kiwi != fig && !heap.contains(fig) && !heap.increaseKey(fig, "zucchini") && !heap.erase(fig));
+    assert(heap.getTop() == "kiwi" && heap.get(kiwi) == "kiwi");
+    assert(heap.extractTop() == "kiwi");
+    (void) kiwi;
+    assert(heap.erase(pear));
+    assert(heap.extractTop() == "apple");
+    assert(heap.isEmpty() && heap.extractTop().empty() && heap.topHandle() == -1);
+  }
+}
+
+template<typename HeapType>
+void benchmarkHeap(const char *name, const std::vector<int> &values) {
+  HeapType heap;
+  auto start = std::chrono::steady_clock::now();
+  for (int value : values) {
+    heap.insert(value);
+  }
+  auto middle = std::chrono::steady_clock::now();
+
+  long long sum = 0;
+  while (!heap.isEmpty()) {
+    sum += heap.extractTop();
+  }
+  auto finish = std::chrono::steady_clock::now();
+
+  std::cout << name << " insert: "
+            << std::chrono::duration_cast<std::chrono::nanoseconds>(middle - start).count() / values.size()
+            << " ns/op, extractTop: "
+            << std::chrono::duration_cast<std::chrono::nanoseconds>(finish - middle).count() / values.size()
+            << " ns/op (sum " << sum << ")" << std::endl;
+}
+
+// std::priority_queue с тем же интерфейсом, что и у Heap
+class StdHeap {
+ public:
+  void insert(int value) {
+    queue.push(value);
+  }
+
+  int extractTop() {
+    int top = queue.top();
+    queue.pop();
+    return top;
+  }
+
+  bool isEmpty() const {
+    return queue.empty();
+  }
+
+ private:
+  std::priority_queue<int> queue;
+};
+
+void benchmarkFruits() {
+  const int count = 1000000;
+  const int k = 1000;
+  std::vector<int> weights(count);
+  for (int i = 0; i < count; ++i) {
+    weights[i] = 1 + std::rand() % k;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  int oneByOne = countStepsOneByOne(weights, k);
+  auto middle = std::chrono::steady_clock::now();
+  int batched = countSteps(weights, k);
+  auto finish = std::chrono::steady_clock::now();
+
+  int buckets = countStepsBuckets(weights, k);
+  auto bucketsFinish = std::chrono::steady_clock::now();
+
+  assert(oneByOne == batched && batched == buckets);
+  std::cout << "fruits one by one: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(middle - start).count()
+            << " ms, batched: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(finish - middle).count()
+            << " ms, buckets: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(bucketsFinish - finish).count()
+            << " ms (" << oneByOne << " / " << batched << " / " << buckets << " steps)" << std::endl;
+}
+
+// Слияние для benchmarkWorkloads: Heap умеет сливаться только поэлементно
+template<typename T, typename Comparator, int Arity>
+void meldInto(Heap<T, Comparator, Arity> &to, Heap<T, Comparator, Arity> &from) {
+  while (!from.isEmpty()) {
+    to.insert(from.extractTop());
+  }
+}
+
+template<typename T, typename Comparator>
+void meldInto(PairingHeap<T, Comparator> &to, PairingHeap<T, Comparator> &from) {
+  to.meld(from);
+}
+
+template<typename HeapType>
+void benchmarkWorkloads(const char *name, const std::vector<int> &values) {
+  const int shards = 1000;
+  long long sum = 0;
+
+  // Вставки с редкими извлечениями: на 16 insert один extractTop
+  auto start = std::chrono::steady_clock::now();
+  {
+    HeapType heap;
+    for (size_t i = 0; i < values.size(); ++i) {
+      heap.insert(values[i]);
+      if (i % 16 == 15) {
+        sum += heap.extractTop();
+      }
+    }
+  }
+  auto insertFinish = std::chrono::steady_clock::now();
+
+  // Заполнение и полное опустошение
+  {
+    HeapType heap;
+    for (int value : values) {
+      heap.insert(value);
+    }
+    while (!heap.isEmpty()) {
+      sum += heap.extractTop();
+    }
+  }
+  auto extractFinish = std::chrono::steady_clock::now();
+
+  // Шарды сливаются в одну кучу, из которой затем достаётся 1% элементов
+  {
+    std::vector<std::unique_ptr<HeapType>> parts;
+    for (int i = 0; i < shards; ++i) {
+      parts.emplace_back(new HeapType());
+    }
+    for (size_t i = 0; i < values.size(); ++i) {
+      parts[i % shards]->insert(values[i]);
+    }
+    for (int i = 1; i < shards; ++i) {
+      meldInto(*parts[0], *parts[i]);
+    }
+    for (size_t i = 0; i < values.size() / 100; ++i) {
+      sum += parts[0]->extractTop();
+    }
+  }
+  auto meldFinish = std::chrono::steady_clock::now();
+
+  std::cout << name << " insert-heavy: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(insertFinish - start).count()
+            << " ms, extract-heavy: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(extractFinish - insertFinish).count()
+            << " ms, meld-heavy: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(meldFinish - extractFinish).count()
+            << " ms (sum " << sum << ")" << std::endl;
+}
+
+void benchmarkMergeable() {
+  const int count = 1000000;
+  std::vector<int> values(count);
+  for (int i = 0; i < count; ++i) {
+    values[i] = std::rand();
+  }
+
+  benchmarkWorkloads<Heap<int>>("Heap", values);
+  benchmarkWorkloads<Heap<int, std::greater<int>, 4>>("Heap<4>", values);
+  benchmarkWorkloads<PairingHeap<int>>("PairingHeap", values);
+}
+
+void benchmark() {
+  const int count = 10000000;
+  std::vector<int> values(count);
+  for (int i = 0; i < count; ++i) {
+    values[i] = std::rand();
+  }
+
+  benchmarkHeap<StdHeap>("std::priority_queue", values);
+  benchmarkHeap<Heap<int, std::greater<int>, 2>>("Heap<2>", values);
+  benchmarkHeap<Heap<int, std::greater<int>, 4>>("Heap<4>", values);
+  benchmarkHeap<Heap<int, std::greater<int>, 8>>("Heap<8>", values);
+  benchmarkFruits();
+  benchmarkMergeable();
 }
 
 int main() {
 //  test();
+//  benchmark();
   run(std::cin, std::cout);
 
   return 0;
@@ -6,6 +6,8 @@
 #include <sstream>
 #include <cassert>
 
+#include "../common/FastInput.h"
+
 struct Data {
   explicit Data(int x = 0, int count = 0)
       : x(x),
@@ -73,7 +75,8 @@ void mergeSort(T array[], int n, Comparator cmp = Comparator()) {
   }
 }
 
-void run(std::istream &is, std::ostream &os) {
+template<typename Input>
+void run(Input &is, std::ostream &os) {
   int n = 0;
   is >> n;
   n *= 2;
@@ -108,6 +111,11 @@ void run(std::istream &is, std::ostream &os) {
   delete[] array;
 }
 
+void run(const char *begin, const char *end, std::ostream &os) {
+  InputReader reader(begin, end);
+  run(reader, os);
+}
+
 void test() {
   {
     std::stringstream input;
@@ -4,6 +4,12 @@
 #include <iostream>
 #include <sstream>
 #include <cassert>
+#include <chrono>
+#include <string>
+#include <fstream>
+#include <cstdlib>
+
+#include "../common/FastInput.h"
 
 int randPivot(int l, int r) {
   return l == r ? l : std::rand() % (r - l) + l;
@@ -45,7 +51,8 @@ int kth_statistic(int array[], int l, int r, int k, Comparator cmp = Comparator(
   return array[pivot];
 }
 
-void run(std::istream &is, std::ostream &os) {
+template<typename Input>
+void run(Input &is, std::ostream &os) {
   int n, k;
   is >> n >> k;
   auto array = new int[n];
@@ -58,6 +65,11 @@ void run(std::istream &is, std::ostream &os) {
   delete[] array;
 }
 
+void run(const char *begin, const char *end, std::ostream &os) {
+  InputReader reader(begin, end);
+  run(reader, os);
+}
+
 void test() {
   {
     std::stringstream input;
@@ -103,11 +115,80 @@ void test() {
 
     assert(output.str() == "4");
   }
+  {
+    std::string input = "10 4\n1 2 4 4 4 4 4 8 9 10\n";
+    std::stringstream output;
+
+    run(input.data(), input.data() + input.size(), output);
+
+    assert(output.str() == "4");
+  }
+  {
+    // Из канала mmap невозможен: MappedInput читает его целиком в буфер
+    std::string input = "10 4\n1 2 4 4 4 4 4 8 9 10\n";
+    int fds[2];
+    if (pipe(fds) != 0) {
+      assert(false);
+      return;
+    }
+    ssize_t written = write(fds[1], input.data(), input.size());
+    close(fds[1]);
+    assert(written == static_cast<ssize_t>(input.size()));
+    (void) written;
+
+    MappedInput mapped(fds[0]);
+    close(fds[0]);
+    std::stringstream output;
+    run(mapped.begin(), mapped.end(), output);
+
+    assert(output.str() == "4");
+  }
+}
+
+void benchmark() {
+  const int n = 1000000;
+  std::stringstream generated;
+  generated << n << " " << n / 2 << std::endl;
+  for (int i = 0; i < n; ++i) {
+    generated << std::rand() - RAND_MAX / 2 << " ";
+  }
+  std::string data = generated.str();
+
+  // Ввод идёт из файла, как у настоящего запуска: ifstream против MappedInput (mmap + InputReader)
+  char path[] = "/tmp/kthXXXXXX";
+  int fd = mkstemp(path);
+  if (fd == -1 || write(fd, data.data(), data.size()) != static_cast<ssize_t>(data.size())) {
+    std::cout << "cannot create " << path << std::endl;
+    return;
+  }
+  close(fd);
+
+  std::stringstream streamOutput;
+  std::stringstream readerOutput;
+
+  auto start = std::chrono::steady_clock::now();
+  {
+    std::ifstream input(path);
+    run(input, streamOutput);
+  }
+  auto middle = std::chrono::steady_clock::now();
+  {
+    MappedInput input(path);
+    run(input.begin(), input.end(), readerOutput);
+  }
+  auto finish = std::chrono::steady_clock::now();
+  unlink(path);
+
+  assert(streamOutput.str() == readerOutput.str());
+  std::cout << "ifstream: " << std::chrono::duration_cast<std::chrono::milliseconds>(middle - start).count() << " ms" << std::endl;
+  std::cout << "MappedInput: " << std::chrono::duration_cast<std::chrono::milliseconds>(finish - middle).count() << " ms" << std::endl;
 }
 
 int main() {
 //  test();
-  run(std::cin, std::cout);
+//  benchmark();
+  MappedInput input(STDIN_FILENO);
+  run(input.begin(), input.end(), std::cout);
 
   return 0;
 }
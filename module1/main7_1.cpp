@@ -10,6 +10,9 @@
 #include <string>
 #include <vector>
 
+#include "../common/FastInput.h"
+#include "../common/FastOutput.h"
+
 void msdSort(std::vector<std::string> &array, int pos, int l, int r) {
   std::vector<int> countBuf(ALPHABET_SIZE, 0);
 
@@ -42,7 +45,8 @@ void msdSort(std::vector<std::string> &array, int pos, int l, int r) {
   }
 }
 
-void run(std::istream &is, std::ostream &os) {
+template<typename Input, typename Output>
+void run(Input &is, Output &os) {
   std::vector<std::string> vec;
   std::string input;
   while (is >> input) {
@@ -56,6 +60,12 @@ void run(std::istream &is, std::ostream &os) {
   }
 }
 
+void run(const char *begin, const char *end, std::ostream &os) {
+  InputReader reader(begin, end);
+  OutputWriter writer(os);
+  run(reader, writer);
+}
+
 void test() {
   {
     std::stringstream input;
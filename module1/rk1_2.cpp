@@ -6,6 +6,30 @@
 #include <iostream>
 #include <cassert>
 #include <sstream>
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+#include <string>
+#include <climits>
+#include <algorithm>
+#include <cmath>
+#include <new>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define STREE_X86
+#include <immintrin.h>
+#endif
+
+#include "../common/FastInput.h"
+#include "../common/ThreadPool.h"
+
+#define CACHE_LINE_SIZE 64
+#define STREE_NODE_SIZE 16
+#define STREE_BATCH_SIZE 8
+#define RADIX_BITS 8
+#define RADIX_SIZE (1 << RADIX_BITS)
+#define GALLOP_RATIO 16
+#define LEARNED_EPSILON 32
 
 int binarySearch(const int *array, int left, int right, int element) {
   while (left < right) {
@@ -21,7 +45,417 @@ int binarySearch(const int *array, int left, int right, int element) {
   return left;
 }
 
-void run(std::istream &is, std::ostream &os) {
+// Тот же массив в порядке обхода в ширину (раскладка Эйтцингера): узел k, дети 2k и 2k + 1.
+// Спуск без ветвлений, а 16 потомков на четыре уровня ниже (одна кэш-линия, включая внуков)
+// подгружаются заранее, поэтому промах по памяти приходится примерно на каждый четвёртый уровень.
+class EytzingerIndex {
+ public:
+  EytzingerIndex(const int *array, int n)
+      : size(n), tree(nullptr), position(nullptr) {
+    position = new int[size + 1];
+    void *memory = nullptr;
+    if (posix_memalign(&memory, CACHE_LINE_SIZE, (size + 1) * sizeof(int)) != 0) {
+      delete[] position;
+      throw std::bad_alloc();
+    }
+    tree = static_cast<int *>(memory);
+    int next = 0;
+    build(array, next, 1);
+  }
+
+  ~EytzingerIndex() {
+    free(tree);
+    delete[] position;
+  }
+
+  // Результат совпадает с binarySearch(array, 0, n, element)
+  int lowerBound(int element) const {
+    int k = 1;
+    while (k <= size) {
+      __builtin_prefetch(tree + 16 * k);
+      k = 2 * k + (tree[k] < element);
+    }
+    k >>= __builtin_ffs(~k);
+
+    return k == 0 ? size : position[k];
+  }
+
+  EytzingerIndex(const EytzingerIndex &other) = delete;
+  EytzingerIndex(EytzingerIndex &&other) = delete;
+  EytzingerIndex &operator=(const EytzingerIndex &other) = delete;
+  EytzingerIndex &operator=(EytzingerIndex &&other) = delete;
+
+ private:
+  int size;
+  int *tree;
+  int *position;
+
+  void build(const int *array, int &next, int k) {
+    if (k > size) {
+      return;
+    }
+
+    build(array, next, 2 * k);
+    tree[k] = array[next];
+    position[k] = next++;
+    build(array, next, 2 * k + 1);
+  }
+};
+
+// Сколько из 16 ключей узла меньше element
+int nodeRankScalar(const int *node, int element) {
+  int rank = 0;
+  for (int i = 0; i < STREE_NODE_SIZE; ++i) {
+    rank += node[i] < element;
+  }
+
+  return rank;
+}
+
+#ifdef STREE_X86
+__attribute__((target("sse2")))
+inline int nodeRankSse2(const int *node, int element) {
+  __m128i x = _mm_set1_epi32(element);
+  int mask = 0;
+  for (int i = 0; i < 4; ++i) {
+    __m128i keys = _mm_load_si128(reinterpret_cast<const __m128i *>(node) + i);
+    mask |= _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(x, keys))) << (4 * i);
+  }
+
+  return __builtin_popcount(mask);
+}
+
+__attribute__((target("avx2")))
+inline int nodeRankAvx2(const int *node, int element) {
+  __m256i x = _mm256_set1_epi32(element);
+  __m256i low = _mm256_cmpgt_epi32(x, _mm256_load_si256(reinterpret_cast<const __m256i *>(node)));
+  __m256i high = _mm256_cmpgt_epi32(x, _mm256_load_si256(reinterpret_cast<const __m256i *>(node) + 1));
+  int mask = _mm256_movemask_ps(_mm256_castsi256_ps(low)) | (_mm256_movemask_ps(_mm256_castsi256_ps(high)) << 8);
+
+  return __builtin_popcount(mask);
+}
+#endif
+
+// Статическое S+-дерево: листья - исходный массив, разбитый на узлы по 16 ключей
+// (хвост дополнен INT_MAX), ключ i внутреннего узла - максимум его ребёнка i.
+// Ранг ключа в узле считается одним векторным сравнением, на каждом уровне
+// читается ровно одна кэш-линия. Если element больше всех ключей, номер ребёнка
+// прижимается к последнему узлу уровня, и спуск естественно приходит к n.
+class STreeIndex {
+ public:
+  STreeIndex(const int *array, int n)
+      : size(n), keys(nullptr) {
+    int nodes = std::max(1, (n + STREE_NODE_SIZE - 1) / STREE_NODE_SIZE);
+    int total = 0;
+    while (true) {
+      levelOffset.push_back(total);
+      levelNodes.push_back(nodes);
+      total += nodes * STREE_NODE_SIZE;
+      if (nodes == 1) {
+        break;
+      }
+      nodes = (nodes + STREE_NODE_SIZE - 1) / STREE_NODE_SIZE;
+    }
+
+    void *memory = nullptr;
+    if (posix_memalign(&memory, CACHE_LINE_SIZE, total * sizeof(int)) != 0) {
+      throw std::bad_alloc();
+    }
+    keys = static_cast<int *>(memory);
+
+    for (int i = 0; i < levelNodes[0] * STREE_NODE_SIZE; ++i) {
+      keys[i] = i < n ? array[i] : INT_MAX;
+    }
+    for (size_t level = 1; level < levelNodes.size(); ++level) {
+      int *current = keys + levelOffset[level];
+      const int *below = keys + levelOffset[level - 1];
+      for (int i = 0; i < levelNodes[level] * STREE_NODE_SIZE; ++i) {
+        current[i] = i < levelNodes[level - 1] ? below[i * STREE_NODE_SIZE + STREE_NODE_SIZE - 1] : INT_MAX;
+      }
+    }
+
+    lowerBoundImpl = &STreeIndex::lowerBoundScalar;
+    batchImpl = &STreeIndex::lowerBoundBatchScalar;
+#ifdef STREE_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+      lowerBoundImpl = &STreeIndex::lowerBoundAvx2;
+      batchImpl = &STreeIndex::lowerBoundBatchAvx2;
+    } else {
+      lowerBoundImpl = &STreeIndex::lowerBoundSse2;
+      batchImpl = &STreeIndex::lowerBoundBatchSse2;
+    }
+#endif
+  }
+
+  ~STreeIndex() {
+    free(keys);
+  }
+
+  // Результат совпадает с binarySearch(array, 0, n, element)
+  int lowerBound(int element) const {
+    return (this->*lowerBoundImpl)(element);
+  }
+
+  // Запросы обрабатываются группами по STREE_BATCH_SIZE, уровень за уровнем,
+  // чтобы промахи по памяти разных запросов перекрывались
+  void lowerBoundBatch(const int *queries, int count, int *result) const {
+    (this->*batchImpl)(queries, count, result);
+  }
+
+  STreeIndex(const STreeIndex &other) = delete;
+  STreeIndex(STreeIndex &&other) = delete;
+  STreeIndex &operator=(const STreeIndex &other) = delete;
+  STreeIndex &operator=(STreeIndex &&other) = delete;
+
+ private:
+  int size;
+  int *keys;
+  std::vector<int> levelOffset;
+  std::vector<int> levelNodes;
+  int (STreeIndex::*lowerBoundImpl)(int) const;
+  void (STreeIndex::*batchImpl)(const int *, int, int *) const;
+
+  template<int (*Rank)(const int *, int)>
+  int search(int element) const {
+    int node = 0;
+    for (int level = static_cast<int>(levelNodes.size()) - 1; level > 0; --level) {
+      int child = node * STREE_NODE_SIZE + Rank(keys + levelOffset[level] + node * STREE_NODE_SIZE, element);
+      node = std::min(child, levelNodes[level - 1] - 1);
+    }
+
+    return std::min(size, node * STREE_NODE_SIZE + Rank(keys + node * STREE_NODE_SIZE, element));
+  }
+
+  template<int (*Rank)(const int *, int)>
+  void searchBatch(const int *queries, int count, int *result) const {
+    int node[STREE_BATCH_SIZE];
+    for (int from = 0; from < count; from += STREE_BATCH_SIZE) {
+      int group = std::min(STREE_BATCH_SIZE, count - from);
+      std::fill(node, node + group, 0);
+      for (int level = static_cast<int>(levelNodes.size()) - 1; level > 0; --level) {
+        const int *layer = keys + levelOffset[level];
+        for (int q = 0; q < group; ++q) {
+          int child = node[q] * STREE_NODE_SIZE + Rank(layer + node[q] * STREE_NODE_SIZE, queries[from + q]);
+          node[q] = std::min(child, levelNodes[level - 1] - 1);
+          __builtin_prefetch(keys + levelOffset[level - 1] + node[q] * STREE_NODE_SIZE);
+        }
+      }
+      for (int q = 0; q < group; ++q) {
+        result[from + q] = std::min(size, node[q] * STREE_NODE_SIZE + Rank(keys + node[q] * STREE_NODE_SIZE, queries[from + q]));
+      }
+    }
+  }
+
+  int lowerBoundScalar(int element) const {
+    return search<nodeRankScalar>(element);
+  }
+
+  void lowerBoundBatchScalar(const int *queries, int count, int *result) const {
+    searchBatch<nodeRankScalar>(queries, count, result);
+  }
+
+#ifdef STREE_X86
+  int lowerBoundSse2(int element) const {
+    return search<nodeRankSse2>(element);
+  }
+
+  void lowerBoundBatchSse2(const int *queries, int count, int *result) const {
+    searchBatch<nodeRankSse2>(queries, count, result);
+  }
+
+  __attribute__((target("avx2")))
+  int lowerBoundAvx2(int element) const {
+    return search<nodeRankAvx2>(element);
+  }
+
+  __attribute__((target("avx2")))
+  void lowerBoundBatchAvx2(const int *queries, int count, int *result) const {
+    searchBatch<nodeRankAvx2>(queries, count, result);
+  }
+#endif
+};
+
+// LSD-сортировка запросов по байтам вместе с их исходными номерами
+void radixSortQueries(const int *queries, int count, std::vector<unsigned> &keys, std::vector<int> &order) {
+  keys.resize(count);
+  order.resize(count);
+  for (int i = 0; i < count; ++i) {
+    keys[i] = static_cast<unsigned>(queries[i]) ^ 0x80000000u;
+    order[i] = i;
+  }
+
+  std::vector<unsigned> keysBuf(count);
+  std::vector<int> orderBuf(count);
+  for (int shift = 0; shift < 32; shift += RADIX_BITS) {
+    int countBuf[RADIX_SIZE + 1] = {0};
+    for (int i = 0; i < count; ++i) {
+      countBuf[((keys[i] >> shift) & (RADIX_SIZE - 1)) + 1]++;
+    }
+    if (countBuf[((keys[0] >> shift) & (RADIX_SIZE - 1)) + 1] == count) {
+      continue;
+    }
+
+    for (int i = 1; i <= RADIX_SIZE; ++i) {
+      countBuf[i] += countBuf[i - 1];
+    }
+    for (int i = 0; i < count; ++i) {
+      int pos = countBuf[(keys[i] >> shift) & (RADIX_SIZE - 1)]++;
+      keysBuf[pos] = keys[i];
+      orderBuf[pos] = order[i];
+    }
+    keys.swap(keysBuf);
+    order.swap(orderBuf);
+  }
+}
+
+// Позиции для отсортированных запросов [from, to) одним проходом: при плотных запросах
+// указатель в массиве двигается линейно, при редких - экспоненциальным поиском от текущей позиции
+void mergeSortedQueries(const int *array, int n, const std::vector<unsigned> &keys, const std::vector<int> &order,
+                        int from, int to, int *result) {
+  if (from >= to) {
+    return;
+  }
+
+  int pos = binarySearch(array, 0, n, static_cast<int>(keys[from] ^ 0x80000000u));
+  bool gallop = static_cast<long long>(n) > static_cast<long long>(GALLOP_RATIO) * (to - from);
+  for (int i = from; i < to; ++i) {
+    int element = static_cast<int>(keys[i] ^ 0x80000000u);
+    if (gallop) {
+      int step = 1;
+      int left = pos;
+      while (pos + step < n && array[pos + step - 1] < element) {
+        left = pos + step;
+        step *= 2;
+      }
+      pos = binarySearch(array, left, std::min(pos + step, n), element);
+    } else {
+      while (pos < n && array[pos] < element) {
+        ++pos;
+      }
+    }
+    result[order[i]] = pos;
+  }
+}
+
+// Для каждого queries[i] записывает в result[i] то же, что binarySearch(array, 0, n, queries[i])
+void insertionPositions(const int *array, int n, const int *queries, int count, int *result) {
+  if (count <= 0) {
+    return;
+  }
+
+  std::vector<unsigned> keys;
+  std::vector<int> order;
+  radixSortQueries(queries, count, keys, order);
+  mergeSortedQueries(array, n, keys, order, 0, count, result);
+}
+
+// То же, но отсортированные запросы делятся на равные части по числу потоков,
+// каждая часть находит свою стартовую позицию бинарным поиском
+void insertionPositions(const int *array, int n, const int *queries, int count, int *result, ThreadPool &pool) {
+  if (count <= 0) {
+    return;
+  }
+
+  std::vector<unsigned> keys;
+  std::vector<int> order;
+  radixSortQueries(queries, count, keys, order);
+
+  int parts = std::min(pool.size(), count);
+  pool.parallelFor(parts, [&](int part) {
+    int from = static_cast<int>(static_cast<long long>(count) * part / parts);
+    int to = static_cast<int>(static_cast<long long>(count) * (part + 1) / parts);
+    mergeSortedQueries(array, n, keys, order, from, to, result);
+  });
+}
+
+// Обучаемый индекс в духе PGM: массив покрывается отрезками прямых "ключ -> позиция",
+// каждая из которых ошибается не больше чем на epsilon позиций. Отрезки строятся
+// жадно сужающимся конусом допустимых наклонов за O(n); запрос находит отрезок,
+// предсказывает позицию и добирает ответ бинарным поиском в окне 2 * epsilon + 3.
+class LearnedIndex {
+ public:
+  LearnedIndex(const int *array, int n, int epsilon = LEARNED_EPSILON)
+      : array(array), epsilon(epsilon) {
+    int start = 0;
+    while (start < n) {
+      double low = 0;
+      double high = INFINITY;
+      int end = start + 1;
+      for (; end < n; ++end) {
+        double dx = static_cast<double>(array[end]) - array[start];
+        double dy = end - start;
+        if (dx == 0) {
+          if (dy > epsilon) {
+            break;
+          }
+          continue;
+        }
+
+        double newLow = std::max(low, (dy - epsilon) / dx);
+        double newHigh = std::min(high, (dy + epsilon) / dx);
+        if (newLow > newHigh) {
+          break;
+        }
+        low = newLow;
+        high = newHigh;
+      }
+
+      firstKeys.push_back(array[start]);
+      segments.push_back({start, end, std::isinf(high) ? low : (low + high) / 2});
+      start = end;
+    }
+  }
+
+  // Результат совпадает с binarySearch(array, 0, n, element).
+  // Берётся последний сегмент, первый ключ которого меньше element: ответ лежит в [start, end]
+  // этого сегмента, даже если серия равных ключей разрезана между сегментами
+  int lowerBound(int element) const {
+    auto next = std::lower_bound(firstKeys.begin(), firstKeys.end(), element);
+    if (next == firstKeys.begin()) {
+      return 0;
+    }
+
+    const Segment &segment = segments[next - firstKeys.begin() - 1];
+    double predicted = segment.start + segment.slope * (static_cast<double>(element) - array[segment.start]);
+    long long guess = static_cast<long long>(predicted);
+    int left = static_cast<int>(std::min<long long>(segment.end, std::max<long long>(segment.start, guess - epsilon - 2)));
+    int right = static_cast<int>(std::min<long long>(segment.end, std::max<long long>(left, guess + epsilon + 3)));
+
+    // Окно модели проверяется по краям; если ответ мог оказаться за ним, ищем по всему сегменту
+    int result = binarySearch(array, left, right, element);
+    bool leftOk = left == segment.start || array[left - 1] < element;
+    bool rightOk = result < right || right == segment.end;
+    if (!leftOk || !rightOk) {
+      result = binarySearch(array, segment.start, segment.end, element);
+    }
+    return result;
+  }
+
+  int segmentsCount() const {
+    return static_cast<int>(segments.size());
+  }
+
+  // Память самого индекса, без исходного массива
+  size_t memoryBytes() const {
+    return segments.size() * (sizeof(Segment) + sizeof(int));
+  }
+
+ private:
+  struct Segment {
+    int start;
+    int end;
+    double slope;
+  };
+
+  const int *array;
+  int epsilon;
+  std::vector<int> firstKeys;
+  std::vector<Segment> segments;
+};
+
+template<typename Input>
+void run(Input &is, std::ostream &os) {
   int n = 0;
   is >> n;
   int *array = new int[n];
@@ -37,6 +471,11 @@ void run(std::istream &is, std::ostream &os) {
   delete[] array;
 }
 
+void run(const char *begin, const char *end, std::ostream &os) {
+  InputReader reader(begin, end);
+  run(reader, os);
+}
+
 void test() {
   {
     std::stringstream input;
@@ -62,10 +501,244 @@ void test() {
 
     assert(output.str() == "1\n");
   }
+  {
+    for (int n = 0; n < 100; ++n) {
+      std::vector<int> array(n);
+      for (int i = 0; i < n; ++i) {
+        array[i] = 3 * i - n;
+      }
+
+      EytzingerIndex index(array.data(), n);
+      for (int element = -n - 2; element < 2 * n + 2; ++element) {
+        assert(index.lowerBound(element) == binarySearch(array.data(), 0, n, element));
+      }
+    }
+  }
+  {
+    for (int n : {0, 1, 15, 16, 17, 255, 256, 257, 4097, 70000}) {
+      std::vector<int> array(n);
+      for (int i = 0; i < n; ++i) {
+        array[i] = 3 * i - n;
+      }
+      if (n > 0) {
+        array[n - 1] = INT_MAX;
+      }
+
+      STreeIndex index(array.data(), n);
+      std::vector<int> queries;
+      for (int element = -n - 2; element < 2 * n + 2; ++element) {
+        queries.push_back(element);
+      }
+      queries.push_back(INT_MIN);
+      queries.push_back(INT_MAX);
+      std::vector<int> batch(queries.size());
+      index.lowerBoundBatch(queries.data(), static_cast<int>(queries.size()), batch.data());
+
+      for (size_t i = 0; i < queries.size(); ++i) {
+        assert(index.lowerBound(queries[i]) == binarySearch(array.data(), 0, n, queries[i]));
+        assert(batch[i] == index.lowerBound(queries[i]));
+      }
+    }
+  }
+  {
+    ThreadPool pool(3);
+    for (int n : {0, 1, 10, 1000, 100000}) {
+      std::vector<int> array(n);
+      for (int i = 0; i < n; ++i) {
+        array[i] = 5 * i - 2 * n;
+      }
+
+      for (int count : {1, 7, 100, 50000}) {
+        std::vector<int> queries(count);
+        for (auto &query : queries) {
+          query = std::rand() % (7 * n + 10) - 3 * n - 5;
+        }
+        queries[0] = INT_MIN;
+        std::vector<int> single(count);
+        std::vector<int> parallel(count);
+        insertionPositions(array.data(), n, queries.data(), count, single.data());
+        insertionPositions(array.data(), n, queries.data(), count, parallel.data(), pool);
+
+        for (int i = 0; i < count; ++i) {
+          assert(single[i] == binarySearch(array.data(), 0, n, queries[i]));
+          assert(parallel[i] == single[i]);
+        }
+      }
+    }
+  }
+  {
+    for (int n : {0, 1, 2, 100, 100000}) {
+      std::vector<int> array(n);
+      int key = -n;
+      for (int i = 0; i < n; ++i) {
+        key += i % 1000 < 500 ? 1 : 1 + std::rand() % 5000;
+        array[i] = key;
+      }
+
+      for (int epsilon : {0, 4, 32}) {
+        LearnedIndex index(array.data(), n, epsilon);
+        for (int i = 0; i < n; ++i) {
+          for (int element = array[i] - 1; element <= array[i] + 1; ++element) {
+            assert(index.lowerBound(element) == binarySearch(array.data(), 0, n, element));
+          }
+        }
+        assert(index.lowerBound(INT_MIN) == 0);
+        assert(index.lowerBound(INT_MAX) == binarySearch(array.data(), 0, n, INT_MAX));
+      }
+    }
+  }
+  {
+    // Серии равных ключей длиннее epsilon и запросы, которых нет в массиве
+    for (int runLength : {1, 3, 100}) {
+      std::vector<int> array;
+      for (int key = 0; key < 40; ++key) {
+        array.insert(array.end(), runLength + key % 3, key * (key % 5 == 0 ? 7 : 2));
+      }
+      std::sort(array.begin(), array.end());
+      int n = static_cast<int>(array.size());
+
+      for (int epsilon : {0, 1, 4, 32}) {
+        LearnedIndex index(array.data(), n, epsilon);
+        for (int element = -3; element <= array.back() + 3; ++element) {
+          assert(index.lowerBound(element) == binarySearch(array.data(), 0, n, element));
+        }
+      }
+    }
+    for (int round = 0; round < 200; ++round) {
+      int n = 1 + std::rand() % 3000;
+      std::vector<int> array(n);
+      int key = std::rand() % 1000 - 500;
+      for (int i = 0; i < n; ++i) {
+        key += std::rand() % 4 == 0 ? std::rand() % 2000 : std::rand() % 2;
+        array[i] = key;
+      }
+
+      LearnedIndex index(array.data(), n, std::rand() % 3 == 0 ? 0 : std::rand() % 16);
+      std::vector<int> queries(200);
+      for (auto &query : queries) {
+        query = array[std::rand() % n] + std::rand() % 5 - 2;
+      }
+      for (size_t i = 0; i < queries.size(); ++i) {
+        assert(index.lowerBound(queries[i]) == binarySearch(array.data(), 0, n, queries[i]));
+      }
+    }
+  }
+}
+
+void benchmark() {
+  const int queriesCount = 1 << 22;
+  for (int n = 1 << 10; n <= 1 << 26; n <<= 2) {
+    std::vector<int> array(n);
+    for (int i = 0; i < n; ++i) {
+      array[i] = 2 * i;
+    }
+    std::vector<int> queries(queriesCount);
+    for (auto &query : queries) {
+      query = std::rand() % (2 * n + 2) - 1;
+    }
+    EytzingerIndex index(array.data(), n);
+    STreeIndex tree(array.data(), n);
+    std::vector<int> batch(queriesCount);
+
+    long long expected = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int query : queries) {
+      expected += binarySearch(array.data(), 0, n, query);
+    }
+    auto middle = std::chrono::steady_clock::now();
+    long long actual = 0;
+    for (int query : queries) {
+      actual += index.lowerBound(query);
+    }
+    auto finish = std::chrono::steady_clock::now();
+    tree.lowerBoundBatch(queries.data(), queriesCount, batch.data());
+    auto batchFinish = std::chrono::steady_clock::now();
+
+    std::vector<int> merged(queriesCount);
+    insertionPositions(array.data(), n, queries.data(), queriesCount, merged.data());
+    auto mergeFinish = std::chrono::steady_clock::now();
+
+    // Суммы печатаются, иначе без assert компилятор выбросит замеряемые циклы
+    long long batchSum = 0;
+    long long mergedSum = 0;
+    for (int i = 0; i < queriesCount; ++i) {
+      assert(merged[i] == batch[i]);
+      batchSum += batch[i];
+      mergedSum += merged[i];
+    }
+    assert(expected == actual);
+    assert(expected == batchSum);
+    std::cout << "n = " << n << " binarySearch: "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(middle - start).count() / queriesCount
+              << " ns, EytzingerIndex: "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(finish - middle).count() / queriesCount
+              << " ns, STreeIndex batch: "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(batchFinish - finish).count() / queriesCount
+              << " ns, sorted merge: "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(mergeFinish - batchFinish).count() / queriesCount
+              << " ns (sum " << expected << " / " << actual << " / " << batchSum << " / " << mergedSum << ")" << std::endl;
+  }
+}
+
+std::vector<int> generateKeys(const std::string &distribution, int n) {
+  std::vector<int> keys(n);
+  long long key = INT_MIN / 2;
+  for (int i = 0; i < n; ++i) {
+    long long gap = 1;
+    if (distribution == "uniform") {
+      gap = 1 + std::rand() % 64;
+    } else if (distribution == "zipf") {
+      // Промежутки с тяжёлым хвостом: P(gap >= g) ~ 1 / g
+      double u = (std::rand() + 1.0) / (RAND_MAX + 2.0);
+      gap = std::min(1LL << 16, static_cast<long long>(1 / u));
+    } else {
+      gap = i % 4096 == 0 ? 1 + std::rand() % (1 << 20) : 1;
+    }
+    key += gap;
+    keys[i] = static_cast<int>(key);
+  }
+
+  return keys;
+}
+
+void benchmarkLearned() {
+  const int n = 1 << 24;
+  const int queriesCount = 1 << 22;
+  for (std::string distribution : {"uniform", "zipf", "clustered"}) {
+    std::vector<int> array = generateKeys(distribution, n);
+    std::vector<int> queries(queriesCount);
+    for (auto &query : queries) {
+      query = array[std::rand() % n] + std::rand() % 3 - 1;
+    }
+    LearnedIndex index(array.data(), n);
+
+    long long expected = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int query : queries) {
+      expected += binarySearch(array.data(), 0, n, query);
+    }
+    auto middle = std::chrono::steady_clock::now();
+    long long actual = 0;
+    for (int query : queries) {
+      actual += index.lowerBound(query);
+    }
+    auto finish = std::chrono::steady_clock::now();
+
+    assert(expected == actual);
+    // Суммы печатаются, иначе без assert цикл LearnedIndex выбрасывается компилятором
+    std::cout << distribution << ": segments " << index.segmentsCount()
+              << ", index " << index.memoryBytes() << " bytes, binarySearch: "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(middle - start).count() / queriesCount
+              << " ns, LearnedIndex: "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(finish - middle).count() / queriesCount
+              << " ns (sum " << expected << " / " << actual << ")" << std::endl;
+  }
 }
 
 int main() {
 //  test();
+//  benchmark();
+//  benchmarkLearned();
   run(std::cin, std::cout);
   return 0;
 }
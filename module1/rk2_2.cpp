@@ -10,6 +10,12 @@
 #include <sstream>
 #include <cassert>
 #include <string>
+#include <vector>
+#include <algorithm>
+
+#include "../common/FastInput.h"
+#include "../common/RawStorage.h"
+#include "../common/ShrinkPolicy.h"
 
 #define FIRST_ALLOC_SIZE 5
 #define REALLOC_SIZE 2
@@ -17,34 +23,65 @@
 template<typename T>
 class Stack {
  public:
-  Stack()
-      : head(0), allocSize(FIRST_ALLOC_SIZE), buffer(new T[allocSize]) {
+  explicit Stack(ShrinkPolicy shrink = ShrinkPolicy())
+      : head(0), allocSize(FIRST_ALLOC_SIZE), buffer(allocateStorage<T>(allocSize)), shrink(shrink) {
   }
 
   ~Stack() {
-    delete[] buffer;
+    destroyElements(buffer, head);
+    freeStorage(buffer);
   }
 
   void Push(T value) {
+    Emplace(std::move(value));
+  }
+
+  // Конструирует элемент прямо в буфере
+  template<typename... Args>
+  void Emplace(Args &&... args) {
     if (allocSize == head) {
-      resize();
+      reallocate(allocSize * REALLOC_SIZE);
     }
 
-    buffer[head++] = value;
+    new(buffer + head) T(std::forward<Args>(args)...);
+    ++head;
   }
 
   T Pop() {
     if (head == 0) {
-      return -1;
+      return emptyValue<T>();
     }
 
-    return buffer[--head];
+    T res = std::move(buffer[--head]);
+    buffer[head].~T();
+
+    int newSize = shrink.onRemove(head, allocSize, FIRST_ALLOC_SIZE);
+    if (newSize != allocSize) {
+      reallocate(newSize);
+    }
+    return res;
   }
 
   bool isEmpty() const {
     return head == 0;
   }
 
+  // Отдаёт лишнюю память: ёмкость становится равна размеру (но не меньше FIRST_ALLOC_SIZE)
+  void ShrinkToFit() {
+    int fit = std::max(head, FIRST_ALLOC_SIZE);
+    if (fit != allocSize) {
+      reallocate(fit);
+    }
+  }
+
+  size_t ReservedBytes() const {
+    return static_cast<size_t>(allocSize) * sizeof(T);
+  }
+
+  size_t UsedBytes() const {
+    return static_cast<size_t>(head) * sizeof(T);
+  }
+
   Stack(const Stack &other) = delete;
   Stack(Stack &&other) = delete;
   Stack &operator=(const Stack &other) = delete;
@@ -54,21 +91,22 @@ class Stack {
   int head;
   int allocSize;
   T *buffer;
+  ShrinkPolicy shrink;
 
-  void resize() {
-    allocSize *= REALLOC_SIZE;
-    auto *newBuffer = new T[allocSize];
-
-    for (int i = 0; i < head; i++) {
-      newBuffer[i] = buffer[i];
-    }
+  // Элементы переносятся в новый буфер перемещением, а не копированием
+  void reallocate(int newSize) {
+    T *newBuffer = allocateStorage<T>(newSize);
 
-    delete[] buffer;
+    relocateElements(newBuffer, buffer, head);
+    freeStorage(buffer);
     buffer = newBuffer;
+    allocSize = newSize;
+    shrink.onResize();
   }
 };
 
-void run(std::istream &is, std::ostream &os) {
+template<typename Input>
+void run(Input &is, std::ostream &os) {
   std::string input;
   std::string output;
 
@@ -108,6 +146,11 @@ void run(std::istream &is, std::ostream &os) {
   os << "YES\n";
 }
 
+void run(const char *begin, const char *end, std::ostream &os) {
+  InputReader reader(begin, end);
+  run(reader, os);
+}
+
 void test() {
   {
     std::stringstream input;
@@ -129,6 +172,36 @@ void test() {
 
     assert(output.str() == "NO\n");
   }
+  {
+    Stack<std::vector<std::string>> stack;
+    for (int i = 0; i < 100; ++i) {
+      stack.Emplace(static_cast<size_t>(i), std::to_string(i));
+    }
+    for (int i = 99; i >= 0; --i) {
+      std::vector<std::string> value = stack.Pop();
+      assert(value.size() == static_cast<size_t>(i) && (i == 0 || value.back() == std::to_string(i)));
+    }
+    assert(stack.isEmpty());
+    assert(stack.Pop().empty());
+  }
+  {
+    Stack<int> stack(ShrinkPolicy(4, 2, 0));
+    for (int i = 0; i < 4096; ++i) {
+      stack.Push(i);
+    }
+    assert(stack.ReservedBytes() >= 4096 * sizeof(int));
+
+    for (int i = 4095; i >= 10; --i) {
+      assert(stack.Pop() == i);
+    }
+    assert(stack.ReservedBytes() <= 4 * stack.UsedBytes() && stack.ReservedBytes() < 4096 * sizeof(int));
+
+    stack.ShrinkToFit();
+    assert(stack.ReservedBytes() == stack.UsedBytes());
+    for (int i = 9; i >= 0; --i) {
+      assert(stack.Pop() == i);
+    }
+  }
 }
 
 int main() {
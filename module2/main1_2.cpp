@@ -13,6 +13,8 @@
 #include <sstream>
 #include <vector>
 
+#include "../common/FastInput.h"
+
 const size_t DEFAULT_SIZE = 8;
 const size_t RESIZE_SIZE = 2;
 const std::string EMPTY_SLOT = "NIL";
@@ -125,7 +127,8 @@ class HashTable {
   std::vector<std::string> table;
 };
 
-void run(std::istream &is, std::ostream &os) {
+template<typename Input>
+void run(Input &is, std::ostream &os) {
   HashTable hashTable;
 
   char op;
@@ -155,6 +158,11 @@ void run(std::istream &is, std::ostream &os) {
   }
 }
 
+void run(const char *begin, const char *end, std::ostream &os) {
+  InputReader reader(begin, end);
+  run(reader, os);
+}
+
 void test() {
   {
     std::stringstream input;
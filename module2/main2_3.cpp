@@ -9,6 +9,10 @@
 #include <cassert>
 #include <sstream>
 #include <stack>
+#include <string>
+
+#include "../common/FastInput.h"
+#include "../common/FastOutput.h"
 
 template<typename T>
 struct Node {
@@ -23,10 +27,10 @@ struct Node {
   Node *right;
 };
 
-template<typename T, typename Comparator = std::less<T>>
+template<typename T, typename Comparator = std::less<T>, typename Output = std::ostream>
 class BinaryTree {
  public:
-  explicit BinaryTree(std::ostream &os)
+  explicit BinaryTree(Output &os)
       : root(nullptr),
         os(os) {
   }
@@ -105,7 +109,7 @@ class BinaryTree {
     while (!tree.empty()) {
       auto node = tree.top();
       tree.pop();
-      os << node->key << " ";
+      os << node->key << ' ';
     }
   }
 
@@ -119,14 +123,15 @@ class BinaryTree {
 
   Comparator cmp;
   Node<T> *root;
-  std::ostream &os;
+  Output &os;
   std::stack<Node<T> *> tree;
 };
 
-void run(std::istream &is, std::ostream &os) {
+template<typename Input, typename Output>
+void run(Input &is, Output &os) {
   size_t n;
   is >> n;
-  BinaryTree<int> binaryTree(os);
+  BinaryTree<int, std::less<int>, Output> binaryTree(os);
   for (size_t i = 0; i < n; ++i) {
     int val;
     is >> val;
@@ -137,6 +142,12 @@ void run(std::istream &is, std::ostream &os) {
   os << std::endl;
 }
 
+void run(const char *begin, const char *end, std::ostream &os) {
+  InputReader reader(begin, end);
+  OutputWriter writer(os);
+  run(reader, writer);
+}
+
 void test() {
   {
     std::stringstream input;
@@ -202,6 +213,14 @@ void test() {
 
     run(input, output);
 
+    assert(output.str() == "1 2 3 7 8 6 5 10 9 4 \n");
+  }
+  {
+    std::string input = "10\n4 3 9 5 6 8 7 2 10 1\n";
+    std::stringstream output;
+
+    run(input.data(), input.data() + input.size(), output);
+
     assert(output.str() == "1 2 3 7 8 6 5 10 9 4 \n");
   }
 }
@@ -17,6 +17,8 @@
 #include <stack>
 #include <queue>
 
+#include "../common/FastInput.h"
+
 template<typename T>
 struct Node {
   explicit Node(T key, int priority = 0)
@@ -256,7 +258,8 @@ class BinaryTree {
   Node<T> *root;
 };
 
-void run(std::istream &is, std::ostream &os) {
+template<typename Input>
+void run(Input &is, std::ostream &os) {
   size_t n;
   is >> n;
   BinaryTree<int> binaryTree;
@@ -272,6 +275,11 @@ void run(std::istream &is, std::ostream &os) {
   os << levelOrder(treap.getRoot()) - levelOrder(binaryTree.getRoot()) << std::endl;
 }
 
+void run(const char *begin, const char *end, std::ostream &os) {
+  InputReader reader(begin, end);
+  run(reader, os);
+}
+
 void test() {
   {
     std::stringstream input;
@@ -11,6 +11,8 @@
 #include <cassert>
 #include <sstream>
 
+#include "../common/FastInput.h"
+
 template<typename T>
 struct Node {
   explicit Node(const T &key)
@@ -265,7 +267,8 @@ class AvlTree {
   Comparator cmp;
 };
 
-void run(std::istream &is, std::ostream &os) {
+template<typename Input>
+void run(Input &is, std::ostream &os) {
   int n;
   is >> n;
   AvlTree<int> avlTree;
@@ -285,6 +288,11 @@ void run(std::istream &is, std::ostream &os) {
   }
 }
 
+void run(const char *begin, const char *end, std::ostream &os) {
+  InputReader reader(begin, end);
+  run(reader, os);
+}
+
 void test() {
   {
     std::stringstream input;
@@ -3,6 +3,8 @@
 #include <sstream>
 #include <stack>
 
+#include "../common/FastInput.h"
+
 template<typename T>
 struct Node {
   explicit Node(T val)
@@ -78,7 +80,8 @@ class BinaryTree {
   Node<T> *root;
 };
 
-void run(std::istream &is, std::ostream &os) {
+template<typename Input>
+void run(Input &is, std::ostream &os) {
   size_t n;
   is >> n;
   BinaryTree<int> binaryTree;
@@ -95,6 +98,11 @@ void run(std::istream &is, std::ostream &os) {
   }
 }
 
+void run(const char *begin, const char *end, std::ostream &os) {
+  InputReader reader(begin, end);
+  run(reader, os);
+}
+
 void test() {
   {
     std::stringstream input;
@@ -3,6 +3,9 @@
 #include <sstream>
 #include <stack>
 
+#include "../common/FastInput.h"
+#include "../common/FastOutput.h"
+
 template<typename T>
 struct Node {
   explicit Node(const T &key)
@@ -49,7 +52,8 @@ class AvlTree {
     return false;
   }
 
-  void PostOrder() {
+  template<typename Output>
+  void PostOrder(Output &os) {
     if (!root) {
       return;
     }
@@ -71,7 +75,7 @@ class AvlTree {
     while (!s2.empty()) {
       auto node = s2.top();
       s2.pop();
-      std::cout << node->key << " ";
+      os << node->key << ' ';
     }
   }
 
@@ -236,7 +240,8 @@ class AvlTree {
   Comparator cmp;
 };
 
-void run(std::istream &is, std::ostream &os) {
+template<typename Input, typename Output>
+void run(Input &is, Output &os) {
   int n;
   is >> n;
   AvlTree<int> avlTree;
@@ -252,7 +257,13 @@ void run(std::istream &is, std::ostream &os) {
     }
   }
 
-  avlTree.PostOrder();
+  avlTree.PostOrder(os);
+}
+
+void run(const char *begin, const char *end, std::ostream &os) {
+  InputReader reader(begin, end);
+  OutputWriter writer(os);
+  run(reader, writer);
 }
 
 void test() {
@@ -274,7 +285,7 @@ void test() {
 
     run(input, output);
 
-    assert(output.str() == "40\n40\n10\n4\n50\n");
+    assert(output.str() == "1 3 2 8 5 4 ");
   }
 }
 
@@ -15,6 +15,9 @@
 #include <vector>
 #include <queue>
 #include <functional>
+#include <limits>
+
+#include "../common/FastInput.h"
 
 class IGraph {
  public:
@@ -110,7 +113,8 @@ int shortestPath(const IGraph &graph, int from, int to) {
   return count[to];
 }
 
-void run(std::istream &is, std::ostream &os) {
+template<typename Input>
+void run(Input &is, std::ostream &os) {
   int v;
   is >> v;
   ListGraph graph(v);
@@ -128,6 +132,11 @@ void run(std::istream &is, std::ostream &os) {
   os << shortestPath(graph, from, to) << '\n';
 }
 
+void run(const char *begin, const char *end, std::ostream &os) {
+  InputReader reader(begin, end);
+  run(reader, os);
+}
+
 void test() {
   {
     std::stringstream input;
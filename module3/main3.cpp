@@ -13,8 +13,11 @@
 #include <sstream>
 #include <vector>
 #include <set>
+#include <limits>
 #include <cassert>
 
+#include "../common/FastInput.h"
+
 struct Vertex {
   Vertex(int vertex, int weight)
       : vertex(vertex),
@@ -97,7 +100,8 @@ int Dijkstra(const ListGraph &graph, int from, int to) {
   return d[to];
 }
 
-void run(std::istream &is, std::ostream &os) {
+template<typename Input>
+void run(Input &is, std::ostream &os) {
   int count;
   is >> count;
   ListGraph graph(count);
@@ -116,6 +120,11 @@ void run(std::istream &is, std::ostream &os) {
   os << Dijkstra(graph, from, to) << '\n';
 }
 
+void run(const char *begin, const char *end, std::ostream &os) {
+  InputReader reader(begin, end);
+  run(reader, os);
+}
+
 void test() {
   {
     std::stringstream input;